@@ -318,7 +318,7 @@ pipeline = {
     };
 assertErrorCode(local, pipeline, [16608, ErrorCodes.BadValue], "division by zero in $expr");
 
-// $graphLookup can only consume at most 100MB of memory.
+// $graphLookup can only consume at most 100MB of memory when it is not allowed to spill to disk.
 foreign.drop();
 
 // Here, the visited set exceeds 100MB.
@@ -343,7 +343,8 @@ pipeline = {
             as: "graph"
         }
     };
-assertErrorCode(local, pipeline, 40099, "maximum memory usage reached");
+assertErrorCode(
+    local, pipeline, 40099, "maximum memory usage reached", {allowDiskUse: false});
 
 // Here, the visited set should grow to approximately 90 MB, and the frontier should push memory
 // usage over 100MB.
@@ -366,7 +367,8 @@ pipeline = {
             as: "out"
         }
     };
-assertErrorCode(local, pipeline, 40099, "maximum memory usage reached");
+assertErrorCode(
+    local, pipeline, 40099, "maximum memory usage reached", {allowDiskUse: false});
 
 // Here, we test that the cache keeps memory usage under 100MB, and does not cause an error.
 foreign.drop();
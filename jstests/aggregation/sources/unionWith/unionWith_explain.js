@@ -28,6 +28,7 @@ for (let i = 0; i < docsPerColl; i++) {
 const executionStatsIngoredFields = [
     "executionTimeMillis",
     "executionTimeMillisEstimate",
+    "documentAllocations",
     "saveState",
     "restoreState",
 ];
@@ -0,0 +1,56 @@
+/**
+ * Tests that $out and $merge produce the same results when their batches are flushed in the
+ * background, and that writes to the same target document are still applied in input order.
+ */
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryDocumentSourceWriterBackgroundFlushers: 4}});
+assert.neq(null, conn, "mongod was unable to start up");
+const testDB = conn.getDB(jsTestName());
+const source = testDB.source;
+const target = testDB.target;
+
+// Pad the documents so that every lane fills several batches before the input is exhausted.
+const kNumDocs = 60 * 1000;
+const kNumKeys = 1000;
+const padding = "x".repeat(1024);
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, k: i % kNumKeys, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+source.aggregate([{$out: target.getName()}]);
+assert.eq(kNumDocs, target.countDocuments({}));
+assert.eq(kNumDocs, target.aggregate([{$group: {_id: "$_id"}}, {$count: "n"}]).next().n);
+
+// Every key is written many times; the last write for each key must win and every write must be
+// counted.
+assert(target.drop());
+source.aggregate([
+    {$sort: {_id: 1}},
+    {$project: {_id: "$k", last: "$_id", count: {$literal: 1}, padding: 1}},
+    {
+        $merge: {
+            into: target.getName(),
+            whenMatched: [{$set: {last: "$$new.last", count: {$add: ["$count", 1]}}}],
+            whenNotMatched: "insert"
+        }
+    }
+]);
+assert.eq(kNumKeys, target.countDocuments({}));
+target.find().forEach((doc) => {
+    assert.eq(kNumDocs / kNumKeys, doc.count, doc);
+    assert.eq(kNumDocs - kNumKeys + doc._id, doc.last, doc);
+});
+
+// An error from a background flush is reported to the client.
+assert(target.drop());
+assert.commandWorked(target.insert({_id: 5}));
+const res = testDB.runCommand({
+    aggregate: source.getName(),
+    pipeline: [{$merge: {into: target.getName(), whenMatched: "fail", whenNotMatched: "insert"}}],
+    cursor: {}
+});
+assert.commandFailedWithCode(res, ErrorCodes.DuplicateKey);
+
+MongoRunner.stopMongod(conn);
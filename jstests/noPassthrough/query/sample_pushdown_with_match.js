@@ -0,0 +1,56 @@
+/**
+ * Verify that a $sample which follows a leading $match is answered by a storage engine random
+ * cursor when enough of the documents match, and is planned as usual otherwise.
+ *
+ * Requires random cursor support.
+ */
+import {aggPlanHasStage} from "jstests/libs/query/analyze_plan.js";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryEnableFilteredSampleFromRandomCursor: true}});
+const testDB = conn.getDB("test");
+const coll = testDB.sample_pushdown_with_match;
+
+const numDocs = 1000;
+let docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    docs.push({a: i, even: i % 2 == 0});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+// Half of the documents match, so a sample of 10 is well below 5% of the matching documents.
+(function testNonSelectiveMatchUsesRandomCursor() {
+    const pipeline = [{$match: {even: true}}, {$sample: {size: 10}}];
+    const explain = coll.explain().aggregate(pipeline);
+    assert(aggPlanHasStage(explain, "$sampleFromRandomCursor"), tojson(explain));
+    assert(!aggPlanHasStage(explain, "$match"), tojson(explain));
+
+    const sampled = coll.aggregate(pipeline).toArray();
+    assert.eq(sampled.length, 10, tojson(sampled));
+    sampled.forEach(doc => assert(doc.even, tojson(sampled)));
+    assert.eq(new Set(sampled.map(doc => doc._id.str)).size, 10, tojson(sampled));
+})();
+
+// Only 1% of the documents match, so the trial fails and the $match may use the index instead.
+(function testSelectiveMatchFallsBack() {
+    const pipeline = [{$match: {a: {$lt: 10}}}, {$sample: {size: 5}}];
+    const explain = coll.explain().aggregate(pipeline);
+    assert(!aggPlanHasStage(explain, "$sampleFromRandomCursor"), tojson(explain));
+    assert(aggPlanHasStage(explain, "IXSCAN"), tojson(explain));
+
+    const sampled = coll.aggregate(pipeline).toArray();
+    assert.eq(sampled.length, 5, tojson(sampled));
+    sampled.forEach(doc => assert.lt(doc.a, 10, tojson(sampled)));
+})();
+
+(function testKnobDisablesFilteredRandomCursor() {
+    assert.commandWorked(testDB.adminCommand(
+        {setParameter: 1, internalQueryEnableFilteredSampleFromRandomCursor: false}));
+    const explain = coll.explain().aggregate([{$match: {even: true}}, {$sample: {size: 10}}]);
+    assert(!aggPlanHasStage(explain, "$sampleFromRandomCursor"), tojson(explain));
+    assert.commandWorked(testDB.adminCommand(
+        {setParameter: 1, internalQueryEnableFilteredSampleFromRandomCursor: true}));
+})();
+
+MongoRunner.stopMongod(conn);
@@ -74,6 +74,14 @@ BSONObj buildSampleObj(long long unsigned int i) {
                        << "random" << random << "phone_no" << phone_no << "long_string"
                        << long_string);
 }
+
+BSONObj buildStringHeavyObj(long long unsigned int i, StringData text) {
+    BSONObjBuilder builder;
+    for (int field = 0; field < 10; ++field) {
+        builder.append(fmt::format("field{}", field), fmt::format("{} {}", text, i * 7919 + field));
+    }
+    return builder.obj();
+}
 }  // namespace
 
 void BM_arrayBuilder(benchmark::State& state) {
@@ -252,6 +260,29 @@ void BM_validate_contents(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// Validates documents made up mostly of string values at the given validation level.
+// 'asciiOnly' chooses between plain ASCII text and text with multi-byte UTF-8 sequences.
+void BM_validate_strings(benchmark::State& state, BSONValidateModeEnum mode, bool asciiOnly) {
+    const std::string asciiText(200, 'x');
+    const std::string mixedText = std::string(60, 'x') +
+        "\xc3\xa9t\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac \xf0\x9f\x98\x8a" + std::string(60, 'y');
+
+    BSONArrayBuilder builder;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++)
+        builder.append(buildStringHeavyObj(j, asciiOnly ? asciiText : mixedText));
+    BSONObj array = builder.done();
+    invariant(validateBSON(array.objdata(), array.objsize(), mode));
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(array.objdata(), array.objsize(), mode));
+        totalSize += array.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayNonStlIterate)->Ranges({{{1}, {100'000}}});
@@ -261,5 +292,15 @@ BENCHMARK(BSONnFields)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_bsonIteratorSortedConstruction)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
 BENCHMARK(BM_validate_contents)->Ranges({{{1}, {1'000}}});
+BENCHMARK_CAPTURE(BM_validate_strings, DefaultAscii, BSONValidateModeEnum::kDefault, true)
+    ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_validate_strings, ExtendedAscii, BSONValidateModeEnum::kExtended, true)
+    ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_validate_strings, FullAscii, BSONValidateModeEnum::kFull, true)->Arg(1'000);
+BENCHMARK_CAPTURE(BM_validate_strings, DefaultMixed, BSONValidateModeEnum::kDefault, false)
+    ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_validate_strings, ExtendedMixed, BSONValidateModeEnum::kExtended, false)
+    ->Arg(1'000);
+BENCHMARK_CAPTURE(BM_validate_strings, FullMixed, BSONValidateModeEnum::kFull, false)->Arg(1'000);
 
 }  // namespace mongo
@@ -43,7 +43,7 @@
 
 namespace mongo {
 
-BufBuilder generateIntegers() {
+BufBuilder generateIntegers(int missingPercent = 5) {
     std::mt19937_64 seedGen(1337);
     std::mt19937 gen(seedGen());
     std::normal_distribution<> d(100, 10);
@@ -57,8 +57,8 @@ BufBuilder generateIntegers() {
 
     // Generate 10k integers
     for (int i = 0; i < 10000; ++i) {
-        // 5% chance for missing
-        if (skip(gen) <= 5) {
+        // 'missingPercent'% chance for missing
+        if (skip(gen) <= missingPercent) {
             s8bBuilder.skip(writeFn);
         } else {
             s8bBuilder.append(std::lround(d(gen)), writeFn);
@@ -253,6 +253,28 @@ void BM_prefixSum(benchmark::State& state) {
     state.SetBytesProcessed(totalBytes);
 }
 
+// Decodes every value through the visitor interface used by block-based BSONColumn decompression.
+// The argument is the percentage of missing values.
+void BM_visitAll(benchmark::State& state) {
+    BufBuilder buffer = generateIntegers(state.range(0));
+    auto size = buffer.len();
+    auto buf = buffer.release();
+
+    size_t totalBytes = 0;
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        uint64_t prev = simple8b::kSingleSkip;
+        int64_t last = 0;
+        benchmark::DoNotOptimize(simple8b::visitAll<int64_t>(
+            buf.get(), size, prev, [&last](int64_t v) { last = v; }, [] {}));
+        benchmark::DoNotOptimize(last);
+        totalBytes += size;
+    }
+
+    state.SetBytesProcessed(totalBytes);
+}
+
 void BM_prefixSumUnoptimized(benchmark::State& state) {
     BufBuilder buffer = generateIntegers();
     auto size = buffer.len();
@@ -292,5 +314,6 @@ BENCHMARK(BM_sum);
 BENCHMARK(BM_sumUnoptimized);
 BENCHMARK(BM_prefixSum);
 BENCHMARK(BM_prefixSumUnoptimized);
+BENCHMARK(BM_visitAll)->Arg(0)->Arg(5);
 
 }  // namespace mongo
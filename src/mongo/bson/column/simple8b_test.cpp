@@ -1546,3 +1546,68 @@ TEST(Simple8b, ResetRLEAfterLargeValue) {
     ASSERT_TRUE((blocks[1] & simple8b_internal::kBaseSelectorMask) ==
                 simple8b_internal::kRleSelector);
 }
+
+TEST(Simple8b, DecodeBlocksWithMissingValueInEverySlot) {
+    // Values of increasing magnitude end up in selectors with increasing bits per slot. Decoding
+    // must give the same results whether a block holds no missing value or one in any slot.
+    for (uint64_t magnitude : {1ull,
+                               3ull,
+                               6ull,
+                               14ull,
+                               30ull,
+                               120ull,
+                               250ull,
+                               1'000ull,
+                               4'000ull,
+                               30'000ull,
+                               1'000'000ull,
+                               1ull << 29,
+                               1ull << 58}) {
+        for (int missingPos = -1; missingPos < 60; ++missingPos) {
+            std::vector<boost::optional<uint64_t>> values;
+            for (int i = 0; i < 60; ++i) {
+                if (i == missingPos) {
+                    values.push_back(boost::none);
+                } else {
+                    values.push_back(i % 2 ? magnitude : magnitude - 1);
+                }
+            }
+            auto [buffer, size] = buildSimple8b(values);
+
+            int64_t expectedSum = 0;
+            int64_t expectedPrefixSum = 0;
+            for (auto&& val : values) {
+                if (val) {
+                    expectedSum = add(expectedSum, Simple8bTypeUtil::decodeInt(*val));
+                    expectedPrefixSum = add(expectedPrefixSum, expectedSum);
+                }
+            }
+
+            uint64_t prev = 0xE;
+            ASSERT_EQ(simple8b::sum<int64_t>(buffer.get(), size, prev), expectedSum);
+
+            prev = 0xE;
+            int64_t prefix = 0;
+            ASSERT_EQ(simple8b::prefixSum<int64_t>(buffer.get(), size, prefix, prev),
+                      expectedPrefixSum);
+
+            std::vector<boost::optional<int64_t>> decodedValues;
+            prev = 0xE;
+            simple8b::visitAll<int64_t>(
+                buffer.get(),
+                size,
+                prev,
+                [&decodedValues](const int64_t v) { decodedValues.push_back(v); },
+                [&decodedValues]() { decodedValues.push_back(0); },
+                [&decodedValues]() { decodedValues.push_back(boost::none); });
+            ASSERT_EQ(decodedValues.size(), values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (values[i]) {
+                    ASSERT_EQ(*decodedValues[i], Simple8bTypeUtil::decodeInt(*values[i]));
+                } else {
+                    ASSERT_EQ(decodedValues[i], boost::none);
+                }
+            }
+        }
+    }
+}
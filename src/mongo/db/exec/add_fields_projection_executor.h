@@ -33,6 +33,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/move/utility_core.hpp>
 #include <boost/none.hpp>
@@ -125,6 +126,10 @@ public:
      */
     void optimize() final {
         _root->optimize();
+
+        std::vector<boost::intrusive_ptr<Expression>*> expressions;
+        _root->collectExpressions(&expressions);
+        eliminateCommonSubexpressions(expressions);
     }
 
     DepsTracker::State addDependencies(DepsTracker* deps) const final {
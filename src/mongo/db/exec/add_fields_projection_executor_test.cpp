@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include <tuple>
 #include <vector>
 
 #include <boost/move/utility_core.hpp>
@@ -43,6 +44,8 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/expression_shared_subexpression.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/unittest/assert.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/framework.h"
@@ -795,5 +798,81 @@ TEST(AddFieldsProjectionExecutorExecutionTest,
     ASSERT_DOCUMENT_EQ(Document{inputProjection}, addFields.serializeTransformation());
 }
 
+//
+// Common subexpression elimination.
+//
+
+bool isShared(const AddFieldsProjectionExecutor& addFields, StringData path) {
+    return dynamic_cast<ExpressionInternalSharedSubexpression*>(
+               addFields.getRoot().getExpressionForPath(FieldPath(path)).get()) != nullptr;
+}
+
+TEST(AddFieldsProjectionExecutorExecutionTest, SharesRepeatedSubexpressionsAcrossFields) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addFields(expCtx);
+    addFields.parse(fromjson("{a: {$toUpper: '$s'}, b: {$concat: [{$toUpper: '$s'}, '-']}, "
+                             "c: {d: {$toUpper: '$s'}}, e: {$expr: {f: {$toLower: '$s'}}}, "
+                             "g: {$expr: {f: {$toLower: '$s'}}}}"));
+    auto serializedBeforeOptimize = addFields.serializeTransformation();
+    addFields.optimize();
+
+    ASSERT_TRUE(isShared(addFields, "a"));
+    ASSERT_TRUE(isShared(addFields, "c.d"));
+    ASSERT_TRUE(isShared(addFields, "e"));
+    ASSERT_TRUE(isShared(addFields, "g"));
+    ASSERT_FALSE(isShared(addFields, "b"));
+
+    // Sharing is invisible in the serialized projection.
+    ASSERT_DOCUMENT_EQ(serializedBeforeOptimize, addFields.serializeTransformation());
+
+    // Each document sees its own values.
+    for (auto&& [s, upper, lower] : {std::tuple{"abc"_sd, "ABC"_sd, "abc"_sd},
+                                     std::tuple{"Xyz"_sd, "XYZ"_sd, "xyz"_sd}}) {
+        auto result = addFields.applyTransformation(Document{{"s", s}});
+        auto expectedResult = Document{{"s", s},
+                                       {"a", upper},
+                                       {"b", std::string{upper} + "-"},
+                                       {"c", Document{{"d", upper}}},
+                                       {"e", Document{{"f", lower}}},
+                                       {"g", Document{{"f", lower}}}};
+        ASSERT_DOCUMENT_EQ(result, expectedResult);
+    }
+}
+
+TEST(AddFieldsProjectionExecutorExecutionTest, DoesNotShareSubexpressionsOfEnclosingVariables) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addFields(expCtx);
+    addFields.parse(fromjson("{a: {$map: {input: '$x', as: 'v', in: {$add: ['$$v', 1]}}}, "
+                             "b: {$map: {input: '$y', as: 'v', in: {$add: ['$$v', 1]}}}, "
+                             "c: {$let: {vars: {v: 1}, in: {$add: ['$$v', '$z']}}}, "
+                             "d: {$let: {vars: {v: 1}, in: {$add: ['$$v', '$z']}}}}"));
+    addFields.optimize();
+
+    // The $let expressions bind the only variable they use, so they can be shared as a whole.
+    ASSERT_TRUE(isShared(addFields, "c"));
+    ASSERT_TRUE(isShared(addFields, "d"));
+
+    auto result = addFields.applyTransformation(
+        Document{{"x", BSON_ARRAY(1 << 2)}, {"y", BSON_ARRAY(10)}, {"z", 5}});
+    auto expectedResult = Document{{"x", BSON_ARRAY(1 << 2)},
+                                   {"y", BSON_ARRAY(10)},
+                                   {"z", 5},
+                                   {"a", BSON_ARRAY(2 << 3)},
+                                   {"b", BSON_ARRAY(11)},
+                                   {"c", 6},
+                                   {"d", 6}};
+    ASSERT_DOCUMENT_EQ(result, expectedResult);
+}
+
+TEST(AddFieldsProjectionExecutorExecutionTest, DoesNotShareNonDeterministicSubexpressions) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addFields(expCtx);
+    addFields.parse(fromjson("{a: {$rand: {}}, b: {$rand: {}}}"));
+    addFields.optimize();
+
+    ASSERT_FALSE(isShared(addFields, "a"));
+    ASSERT_FALSE(isShared(addFields, "b"));
+}
+
 }  // namespace
 }  // namespace mongo::projection_executor
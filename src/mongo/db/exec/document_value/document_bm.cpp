@@ -29,8 +29,10 @@
 
 #include <benchmark/benchmark.h>
 #include <cstddef>
+#include <fmt/format.h>
 #include <map>
 #include <string>
+#include <vector>
 
 
 #include "mongo/base/string_data.h"
@@ -110,5 +112,60 @@ void BM_FieldNameHasher(benchmark::State& state) {
 
 BENCHMARK(BM_FieldNameHasher)->RangeMultiplier(2)->Range(1, 1 << 8);
 
+/**
+ * Benchmarks building a document field by field and releasing it, as stages like $project do for
+ * every input document. The 'bufferAcquisitions' counter reports the number of cache buffers
+ * requested per document, which includes the reallocations done while the cache grows.
+ */
+void BM_documentBuildAndRelease(benchmark::State& state) {
+    std::vector<std::string> fieldNames;
+    for (auto i = 0; i < state.range(0); i++) {
+        fieldNames.push_back(fmt::format("field{}", i));
+    }
+
+    const auto acquisitionsBefore = DocumentStorage::threadCacheBufferAcquisitions();
+    for (auto _ : state) {
+        MutableDocument md;
+        for (auto i = 0; i < state.range(0); i++) {
+            md.addField(StringData{fieldNames[i]}, Value(i));
+        }
+        benchmark::DoNotOptimize(md.freeze());
+    }
+    state.counters["bufferAcquisitions"] =
+        benchmark::Counter(DocumentStorage::threadCacheBufferAcquisitions() - acquisitionsBefore,
+                           benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_documentBuildAndRelease)->RangeMultiplier(2)->Range(1, 64);
+
+/**
+ * Benchmarks adding a computed field to documents backed by BSON, as $addFields does.
+ */
+void BM_documentAddFieldToBson(benchmark::State& state) {
+    std::vector<Document> inputs;
+    for (auto i = 0; i < 1'000; i++) {
+        BSONObjBuilder bob;
+        for (auto j = 0; j < state.range(0); j++) {
+            bob.append(fmt::format("field{}", j), i * j);
+        }
+        inputs.emplace_back(bob.obj());
+    }
+
+    const auto acquisitionsBefore = DocumentStorage::threadCacheBufferAcquisitions();
+    for (auto _ : state) {
+        for (auto&& input : inputs) {
+            MutableDocument md(input);
+            md.addField("computed"_sd, Value(1));
+            benchmark::DoNotOptimize(md.freeze());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * inputs.size());
+    state.counters["bufferAcquisitions"] =
+        benchmark::Counter(DocumentStorage::threadCacheBufferAcquisitions() - acquisitionsBefore,
+                           benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_documentAddFieldToBson)->RangeMultiplier(4)->Range(4, 64);
+
 
 }  // namespace mongo
@@ -500,6 +500,20 @@ public:
         return !_cache ? 0 : (_cacheEnd - _cache + hashTabBytes());
     }
 
+    /**
+     * Returns the number of cache buffers acquired by DocumentStorage instances on the calling
+     * thread so far, whether they were newly allocated or recycled. Callers take the difference
+     * between two readings to attribute buffer allocations to a piece of work.
+     */
+    static uint64_t threadCacheBufferAcquisitions();
+
+    /**
+     * Returns the number of bytes that threads have reserved for recycling cache buffers. Each
+     * thread that pools buffers reserves a fixed share when it first keeps one and returns it when
+     * it exits, and the total is capped, so this bounds the memory held by all the pools.
+     */
+    static size_t cacheBufferPoolReservedBytes();
+
     auto bsonObjSize() const {
         return _bson.objsize();
     }
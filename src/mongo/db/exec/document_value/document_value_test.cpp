@@ -63,6 +63,7 @@
 #include "mongo/logv2/log_attr.h"
 #include "mongo/logv2/log_component.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/assert.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/framework.h"
@@ -428,6 +429,57 @@ TEST(DocumentSize, ApproximateSizeDuringBuildIsUpdated) {
     ASSERT_EQ(beforeFreezeSize, frozenSize);
 }
 
+TEST(DocumentCacheBuffers, AcquisitionsAreCountedPerThread) {
+    const auto before = DocumentStorage::threadCacheBufferAcquisitions();
+    MutableDocument builder;
+    for (int i = 0; i < 20; ++i) {
+        builder.addField(StringData{"a" + std::to_string(i)}, Value(i));
+    }
+    Document result = builder.freeze();
+
+    // Growing the cache to hold 20 fields takes more than one buffer.
+    ASSERT_GT(DocumentStorage::threadCacheBufferAcquisitions() - before, 1u);
+}
+
+TEST(DocumentCacheBuffers, RecycledBuffersDoNotLeakFields) {
+    {
+        MutableDocument builder;
+        for (int i = 0; i < 10; ++i) {
+            builder.addField(StringData{"old" + std::to_string(i)}, Value(i));
+        }
+        builder.freeze();
+    }
+
+    // The buffers released above are likely to be reused here, as this builder grows through the
+    // same sizes.
+    MutableDocument builder;
+    for (int i = 0; i < 10; ++i) {
+        builder.addField(StringData{"new" + std::to_string(i)}, Value(i * 2));
+    }
+    Document result = builder.freeze();
+
+    ASSERT_EQ(result.computeSize(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_VALUE_EQ(result[StringData{"new" + std::to_string(i)}], Value(i * 2));
+        ASSERT(result[StringData{"old" + std::to_string(i)}].missing());
+    }
+    ASSERT_DOCUMENT_EQ(result, result.shred());
+}
+
+TEST(DocumentCacheBuffers, ThreadReturnsPoolReservationOnExit) {
+    const auto before = DocumentStorage::cacheBufferPoolReservedBytes();
+    stdx::thread worker([] {
+        MutableDocument builder;
+        for (int i = 0; i < 10; ++i) {
+            builder.addField(StringData{"a" + std::to_string(i)}, Value(i));
+        }
+        builder.freeze();
+    });
+    worker.join();
+
+    ASSERT_EQ(DocumentStorage::cacheBufferPoolReservedBytes(), before);
+}
+
 TEST(ShredDocument, OutputHasNoBackingBSON) {
     BSONObj bson =
         BSON("a" << 1 << "subObj" << BSON("a" << 1) << "subArray" << BSON_ARRAY(BSON("a" << 1)));
@@ -43,6 +43,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonelement.h"
@@ -268,6 +269,10 @@ public:
     void optimize() final {
         ProjectionExecutor::optimize();
         _root->optimize();
+
+        std::vector<boost::intrusive_ptr<Expression>*> expressions;
+        _root->collectExpressions(&expressions);
+        eliminateCommonSubexpressions(expressions);
     }
 
     DepsTracker::State addDependencies(DepsTracker* deps) const final {
@@ -123,6 +123,12 @@ struct CommonStats {
     // cache. This struct includes the execution time and its precision/unit.
     QueryExecTime executionTime;
 
+    // Number of Document cache buffers acquired while working inside this stage, including its
+    // children. Only collected by aggregation stages, when execution stats are requested: the
+    // per-thread acquisition counter is always maintained, but a stage only reads it from the
+    // explain branch of DocumentSource::getNext().
+    size_t documentAllocations = 0;
+
     bool failed;
     bool isEOF;
 };
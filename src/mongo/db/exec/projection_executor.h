@@ -35,8 +35,10 @@
 #include <boost/smart_ptr.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <fmt/format.h>
+#include <iterator>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonelement.h"
@@ -47,10 +49,12 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/expression_shared_subexpression.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/transformer_interface.h"
 #include "mongo/db/pipeline/variables.h"
 #include "mongo/db/query/projection_policies.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/intrusive_counter.h"
@@ -94,6 +98,7 @@ public:
      * Apply the projection transformation.
      */
     Document applyTransformation(const Document& input) const override {
+        ExpressionInternalSharedSubexpression::TemporaryScope temporaries(_temporaries, input);
         auto output = applyProjection(input);
         if (_rootReplacementExpression) {
             return _applyRootReplacementExpression(input, output);
@@ -138,6 +143,22 @@ protected:
      */
     virtual Document applyProjection(const Document& input) const = 0;
 
+    /**
+     * Arranges for subexpressions which occur more than once among 'expressions' to be evaluated
+     * once per document by 'applyTransformation()'. Should be called once the expressions have
+     * been optimized.
+     */
+    void eliminateCommonSubexpressions(
+        const std::vector<boost::intrusive_ptr<Expression>*>& expressions) {
+        if (!internalQueryProjectionEliminateCommonSubexpressions.load()) {
+            return;
+        }
+        auto temporaries = expression::eliminateCommonSubexpressions(expressions);
+        _temporaries.insert(_temporaries.end(),
+                            std::make_move_iterator(temporaries.begin()),
+                            std::make_move_iterator(temporaries.end()));
+    }
+
     boost::intrusive_ptr<ExpressionContext> _expCtx;
 
     ProjectionPolicies _policies;
@@ -161,5 +182,8 @@ private:
     // root-replacement expressions which apply projection to the entire post-image document, rather
     // than to a specific field.
     Variables::Id _projectionPostImageVarId;
+
+    // Per-document values of the subexpressions shared by eliminateCommonSubexpressions().
+    ExpressionInternalSharedSubexpression::TemporaryVector _temporaries;
 };
 }  // namespace mongo::projection_executor
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/projection_node.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/expression_shared_subexpression.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/str.h"
@@ -330,6 +331,16 @@ void ProjectionNode::optimize() {
     _maxFieldsToProject = maxFieldsToProject();
 }
 
+void ProjectionNode::collectExpressions(
+    std::vector<boost::intrusive_ptr<Expression>*>* expressions) {
+    for (auto&& expressionPair : _expressions) {
+        expressions->push_back(&expressionPair.second);
+    }
+    for (auto&& childPair : _children) {
+        childPair.second->collectExpressions(expressions);
+    }
+}
+
 Document ProjectionNode::serialize(const SerializationOptions& options) const {
     MutableDocument outputDoc;
     serialize(&outputDoc, options);
@@ -366,7 +377,13 @@ void ProjectionNode::serialize(MutableDocument* output, const SerializationOptio
                     "reached end of the expression iterator",
                     expressionIt != _expressions.end());
 
-            auto isExpressionObject = dynamic_cast<ExpressionObject*>(expressionIt->second.get());
+            // A shared subexpression serializes as the expression it wraps.
+            const Expression* expression = expressionIt->second.get();
+            if (auto shared =
+                    dynamic_cast<const ExpressionInternalSharedSubexpression*>(expression)) {
+                expression = shared->getChild();
+            }
+            auto isExpressionObject = dynamic_cast<const ExpressionObject*>(expression);
 
             if (isExpressionObject) {
                 output->addField(
@@ -157,6 +157,12 @@ public:
 
     void optimize();
 
+    /**
+     * Recursively appends the address of each computed field's expression to 'expressions', so
+     * that the caller can replace the expressions in place.
+     */
+    void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions);
+
     Document serialize(const SerializationOptions& options) const;
 
     void serialize(MutableDocument* output, const SerializationOptions& options) const;
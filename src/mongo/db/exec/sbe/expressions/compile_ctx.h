@@ -46,6 +46,10 @@ namespace mongo::sbe {
 using SpoolBuffer = std::vector<value::MaterializedRow>;
 class PlanStage;
 
+namespace bson {
+class FieldOffsetIndex;
+}  // namespace bson
+
 struct CompileCtx {
     CompileCtx(std::unique_ptr<RuntimeEnvironment> env) : _env{std::move(env)} {}
 
@@ -88,6 +92,12 @@ struct CompileCtx {
     vm::LabelId lastLabelId{0};
     RemoteCursorMap* remoteCursors{nullptr};
 
+    /**
+     * Field offset indexes that plan stages keep over the objects in their slots, keyed by the
+     * accessor of the slot. Field lookups on such a slot are compiled to use its index.
+     */
+    stdx::unordered_map<const value::SlotAccessor*, bson::FieldOffsetIndex*> fieldIndexes;
+
 private:
     // Any data that a PlanStage needs from the RuntimeEnvironment should not be accessed directly
     // but insteady by looking up the corresponding slots. These slots are set up during the process
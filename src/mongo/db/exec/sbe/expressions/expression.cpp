@@ -969,6 +969,13 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
      BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::aggRemovableBottomNRemove, true}},
     {"aggRemovableBottomNFinalize",
      BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggRemovableBottomNFinalize, false}},
+    {"aggRemovablePercentileAdd",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggRemovablePercentileAdd, true}},
+    {"aggRemovablePercentileRemove",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggRemovablePercentileRemove, true}},
+    {"aggRemovablePercentileFinalize",
+     BuiltinFn{
+         [](size_t n) { return n == 2; }, vm::Builtin::aggRemovablePercentileFinalize, false}},
     {"valueBlockExists",
      BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::valueBlockExists, false}},
     {"valueBlockTypeMatch",
@@ -1138,6 +1145,21 @@ vm::CodeFragment generator(CompileCtx& ctx, const EExpression::Vector& nodes, bo
     return code;
 }
 
+/**
+ * Returns the field offset index kept over the object in the slot read by 'e', if 'e' reads a slot
+ * and the stage that fills it keeps one.
+ */
+bson::FieldOffsetIndex* getFieldIndex(CompileCtx& ctx, const EExpression* e) {
+    auto var = e->as<EVariable>();
+    if (!var || var->getFrameId() || ctx.fieldIndexes.empty()) {
+        return nullptr;
+    }
+    auto slot = var->getSlotId();
+    auto accessor = ctx.root ? ctx.root->getAccessor(ctx, slot) : ctx.getAccessor(slot);
+    auto it = ctx.fieldIndexes.find(accessor);
+    return it != ctx.fieldIndexes.end() ? it->second : nullptr;
+}
+
 vm::CodeFragment generateGetField(CompileCtx& ctx, const EExpression::Vector& nodes, bool) {
     vm::CodeFragment code;
 
@@ -1147,8 +1169,13 @@ vm::CodeFragment generateGetField(CompileCtx& ctx, const EExpression::Vector& no
         if (value::isString(tag)) {
             auto fieldName = value::getStringView(tag, val);
             if (fieldName.size() < vm::Instruction::kMaxInlineStringSize) {
+                auto fieldIndex = getFieldIndex(ctx, nodes[0].get());
                 auto param = appendParameter(code, ctx, nodes[0].get());
-                code.appendGetField(param, fieldName);
+                if (fieldIndex) {
+                    code.appendGetField(param, fieldName, fieldIndex);
+                } else {
+                    code.appendGetField(param, fieldName);
+                }
 
                 return code;
             }
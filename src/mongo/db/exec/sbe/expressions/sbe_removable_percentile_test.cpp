@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/docval_to_sbeval.h"
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/unittest/assert.h"
+#include "mongo/unittest/framework.h"
+
+namespace mongo::sbe {
+
+enum class RemovablePercentileOp { kAdd, kRemove };
+
+class SBERemovablePercentileTest : public EExpressionTestFixture {
+public:
+    void runAndAssertExpression(std::vector<std::pair<value::TypeTags, value::Value>>& inputValues,
+                                std::vector<RemovablePercentileOp>& operations,
+                                std::vector<std::pair<value::TypeTags, value::Value>>& expValues) {
+        value::ViewOfValueAccessor inputAccessor;
+        auto inputSlot = bindAccessor(&inputAccessor);
+
+        value::OwnedValueAccessor aggAccessor;
+        auto aggSlot = bindAccessor(&aggAccessor);
+
+        auto aggRemovablePercentileAdd = sbe::makeE<sbe::EFunction>(
+            "aggRemovablePercentileAdd", sbe::makeEs(makeE<EVariable>(inputSlot)));
+        auto compiledAdd = compileAggExpression(*aggRemovablePercentileAdd, &aggAccessor);
+
+        auto aggRemovablePercentileRemove = sbe::makeE<sbe::EFunction>(
+            "aggRemovablePercentileRemove", sbe::makeEs(makeE<EVariable>(inputSlot)));
+        auto compiledRemove = compileAggExpression(*aggRemovablePercentileRemove, &aggAccessor);
+
+        auto [psTag, psVal] = value::makeValue(Value(BSON_ARRAY(0.0 << 0.5 << 1.0)));
+        auto aggRemovablePercentileFinalize = sbe::makeE<sbe::EFunction>(
+            "aggRemovablePercentileFinalize",
+            sbe::makeEs(makeE<EVariable>(aggSlot), makeE<EConstant>(psTag, psVal)));
+        auto compiledFinalize = compileExpression(*aggRemovablePercentileFinalize);
+
+        // Call the RemovablePercentileOp (Add/Remove) on the inputs and call finalize() after
+        // each op.
+        size_t addIdx = 0, removeIdx = 0;
+        for (size_t i = 0; i < operations.size(); ++i) {
+            vm::CodeFragment* compiledExpr;
+            size_t idx;
+            if (operations[i] == RemovablePercentileOp::kAdd) {
+                compiledExpr = compiledAdd.get();
+                idx = addIdx++;
+            } else {
+                compiledExpr = compiledRemove.get();
+                idx = removeIdx++;
+            }
+            inputAccessor.reset(inputValues[idx].first, inputValues[idx].second);
+            auto [runTag, runVal] = runCompiledExpression(compiledExpr);
+            ASSERT_EQ(runTag, value::TypeTags::orderStatisticTree);
+
+            aggAccessor.reset(runTag, runVal);
+            auto out = runCompiledExpression(compiledFinalize.get());
+
+            ASSERT_THAT(out, ValueEq(expValues[i]));
+
+            value::releaseValue(out.first, out.second);
+            value::releaseValue(expValues[i].first, expValues[i].second);
+        }
+        for (size_t i = 0; i < inputValues.size(); ++i) {
+            value::releaseValue(inputValues[i].first, inputValues[i].second);
+        }
+    }
+};
+
+TEST_F(SBERemovablePercentileTest, BasicTest) {
+    // Removals happen in the same order as the additions, like a sliding window.
+    std::vector<std::pair<value::TypeTags, value::Value>> inputValues = {
+        {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(3)},
+        {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1)},
+        value::makeNewString("not a number"),
+        {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2)},
+    };
+
+    std::vector<RemovablePercentileOp> ops = {RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kRemove,
+                                              RemovablePercentileOp::kRemove,
+                                              RemovablePercentileOp::kRemove,
+                                              RemovablePercentileOp::kRemove};
+
+    std::vector<std::pair<value::TypeTags, value::Value>> expValues = {
+        value::makeValue(Value(BSON_ARRAY(3.0 << 3.0 << 3.0))),
+        value::makeValue(Value(BSON_ARRAY(1.0 << 1.0 << 3.0))),
+        value::makeValue(Value(BSON_ARRAY(1.0 << 1.0 << 3.0))),
+        value::makeValue(Value(BSON_ARRAY(1.0 << 2.0 << 3.0))),
+        value::makeValue(Value(BSON_ARRAY(1.0 << 1.0 << 2.0))),
+        value::makeValue(Value(BSON_ARRAY(2.0 << 2.0 << 2.0))),
+        value::makeValue(Value(BSON_ARRAY(2.0 << 2.0 << 2.0))),
+        value::makeValue(Value(BSON_ARRAY(BSONNULL << BSONNULL << BSONNULL))),
+    };
+
+    runAndAssertExpression(inputValues, ops, expValues);
+}
+
+TEST_F(SBERemovablePercentileTest, MixedNumericTypes) {
+    std::vector<std::pair<value::TypeTags, value::Value>> inputValues = {
+        {value::TypeTags::NumberDouble,
+         value::bitcastFrom<double>(std::numeric_limits<double>::quiet_NaN())},
+        {value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(5)},
+        value::makeCopyDecimal(Decimal128("2.5")),
+    };
+
+    std::vector<RemovablePercentileOp> ops = {RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kAdd,
+                                              RemovablePercentileOp::kRemove,
+                                              RemovablePercentileOp::kRemove,
+                                              RemovablePercentileOp::kRemove};
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<std::pair<value::TypeTags, value::Value>> expValues = {
+        value::makeValue(Value(BSON_ARRAY(nan << nan << nan))),
+        value::makeValue(Value(BSON_ARRAY(nan << nan << 5.0))),
+        value::makeValue(Value(BSON_ARRAY(nan << 2.5 << 5.0))),
+        value::makeValue(Value(BSON_ARRAY(2.5 << 2.5 << 5.0))),
+        value::makeValue(Value(BSON_ARRAY(2.5 << 2.5 << 2.5))),
+        value::makeValue(Value(BSON_ARRAY(BSONNULL << BSONNULL << BSONNULL))),
+    };
+
+    runAndAssertExpression(inputValues, ops, expValues);
+}
+}  // namespace mongo::sbe
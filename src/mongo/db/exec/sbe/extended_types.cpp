@@ -41,6 +41,7 @@
 #include "mongo/db/exec/sbe/values/value_builder.h"
 #include "mongo/db/exec/sbe/values/value_printer.h"
 #include "mongo/db/matcher/in_list_data.h"
+#include "mongo/db/pipeline/window_function/order_statistic_tree.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/storage/key_string/key_string.h"
@@ -262,6 +263,30 @@ struct InListOps {
 
     static constexpr ExtendedTypeOps typeOps{&makeCopy, &release, &print, &getApproxSize};
 };
+
+struct OrderStatisticTreeOps {
+    static std::pair<TypeTags, Value> makeCopy(Value val) {
+        auto& tree = *value::getOrderStatisticTreeView(val);
+        auto copy = value::bitcastFrom<OrderStatisticTree*>(new OrderStatisticTree(tree));
+        return {TypeTags::orderStatisticTree, copy};
+    }
+
+    static void release(Value val) {
+        delete value::getOrderStatisticTreeView(val);
+    }
+
+    static std::string print(Value val) {
+        std::stringstream ss;
+        ss << "OrderStatisticTree(size: " << value::getOrderStatisticTreeView(val)->size() << ")";
+        return ss.str();
+    }
+
+    static size_t getApproxSize(Value val) {
+        return value::getOrderStatisticTreeView(val)->memUsageBytes();
+    }
+
+    static constexpr ExtendedTypeOps typeOps{&makeCopy, &release, &print, &getApproxSize};
+};
 }  // namespace
 
 MONGO_INITIALIZER(ExtendedSbeTypes)(InitializerContext* context) {
@@ -273,5 +298,6 @@ MONGO_INITIALIZER(ExtendedSbeTypes)(InitializerContext* context) {
     value::registerExtendedTypeOps(TypeTags::makeObjSpec, &MakeObjSpecOps::typeOps);
     value::registerExtendedTypeOps(TypeTags::indexBounds, &IndexBoundsOps::typeOps);
     value::registerExtendedTypeOps(TypeTags::inList, &InListOps::typeOps);
+    value::registerExtendedTypeOps(TypeTags::orderStatisticTree, &OrderStatisticTreeOps::typeOps);
 }
 }  // namespace mongo::sbe
@@ -172,6 +172,10 @@ void ScanStage::prepare(CompileCtx& ctx) {
         }
     }
 
+    if (_state->recordSlot) {
+        ctx.fieldIndexes[&_recordAccessor] = &_recordFieldIndex;
+    }
+
     if (_state->seekRecordIdSlot) {
         _seekRecordIdAccessor = ctx.getAccessor(*(_state->seekRecordIdSlot));
     }
@@ -229,6 +233,9 @@ value::SlotAccessor* ScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot)
 }
 
 void ScanStage::doSaveState(bool relinquishCursor) {
+    // The record may be copied or released below.
+    _recordFieldIndex.clear();
+
 #if defined(MONGO_CONFIG_DEBUG_BUILD)
     if (slotsAccessible()) {
         if (_state->recordSlot &&
@@ -463,6 +470,7 @@ PlanState ScanStage::getNext() {
     // We are about to call next() on a storage cursor so do not bother saving our internal state in
     // case it yields as the state will be completely overwritten after the next() call.
     disableSlotAccess();
+    _recordFieldIndex.clear();
 
     // This call to checkForInterrupt() may result in a call to save() or restore() on the entire
     // PlanStage tree if a yield occurs. It's important that we call checkForInterrupt() before
@@ -577,6 +585,7 @@ PlanState ScanStage::getNext() {
         _recordAccessor.reset(false,
                               value::TypeTags::bsonObject,
                               value::bitcastFrom<const char*>(nextRecord->data.data()));
+        _recordFieldIndex.reset(nextRecord->data.data());
     }
 
     if (_state->recordIdSlot) {
@@ -664,6 +673,7 @@ void ScanStage::close() {
     auto optTimer(getOptTimer(_opCtx));
 
     trackClose();
+    _recordFieldIndex.clear();
     _indexCatalogEntryMap.clear();
     _cursor.reset();
     _randomCursor.reset();
@@ -906,6 +916,10 @@ void ParallelScanStage::prepare(CompileCtx& ctx) {
             4822817, str::stream() << "duplicate field: " << _scanFieldSlots[idx], insertedRename);
     }
 
+    if (_recordSlot) {
+        ctx.fieldIndexes[&_recordAccessor] = &_recordFieldIndex;
+    }
+
     if (_snapshotIdSlot) {
         _snapshotIdAccessor = ctx.getAccessor(*_snapshotIdSlot);
     }
@@ -943,6 +957,9 @@ value::SlotAccessor* ParallelScanStage::getAccessor(CompileCtx& ctx, value::Slot
 }
 
 void ParallelScanStage::doSaveState(bool relinquishCursor) {
+    // The record may be copied or released below.
+    _recordFieldIndex.clear();
+
 #if defined(MONGO_CONFIG_DEBUG_BUILD)
     _lastReturned.clear();
     if (slotsAccessible()) {
@@ -1101,6 +1118,7 @@ PlanState ParallelScanStage::getNext() {
     // We are about to call next() on a storage cursor so do not bother saving our internal state in
     // case it yields as the state will be completely overwritten after the next() call.
     disableSlotAccess();
+    _recordFieldIndex.clear();
 
     if (!_cursor) {
         return trackPlanState(PlanState::IS_EOF);
@@ -1154,6 +1172,7 @@ PlanState ParallelScanStage::getNext() {
         _recordAccessor.reset(false,
                               value::TypeTags::bsonObject,
                               value::bitcastFrom<const char*>(nextRecord->data.data()));
+        _recordFieldIndex.reset(nextRecord->data.data());
     }
 
     if (_recordIdSlot) {
@@ -1195,6 +1214,7 @@ void ParallelScanStage::close() {
     auto optTimer(getOptTimer(_opCtx));
 
     trackClose();
+    _recordFieldIndex.clear();
     _indexCatalogEntryMap.clear();
     _cursor.reset();
     _coll.reset();
@@ -52,6 +52,7 @@
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/util/debug_print.h"
 #include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
 #include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/plan_yield_policy.h"
@@ -293,6 +294,10 @@ private:
     // Holds the current record.
     value::OwnedValueAccessor _recordAccessor;
 
+    // Field lookups on '_recordAccessor' compiled anywhere in the plan are given this index. It
+    // is reset for every record and cleared before the record may be released.
+    bson::FieldOffsetIndex _recordFieldIndex;
+
     // Holds the RecordId of the current record as a TypeTags::RecordId.
     value::OwnedValueAccessor _recordIdAccessor;
     RecordId _recordId;
@@ -470,6 +475,10 @@ private:
     // Holds the current record.
     value::OwnedValueAccessor _recordAccessor;
 
+    // Field lookups on '_recordAccessor' compiled anywhere in the plan are given this index. It
+    // is reset for every record and cleared before the record may be released.
+    bson::FieldOffsetIndex _recordFieldIndex;
+
     // Holds the RecordId of the current record as a TypeTags::RecordId.
     value::OwnedValueAccessor _recordIdAccessor;
     RecordId _recordId;
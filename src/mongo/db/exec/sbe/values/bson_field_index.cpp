@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
+
+#include "mongo/db/exec/sbe/values/bson.h"
+
+namespace mongo {
+namespace sbe {
+namespace bson {
+std::pair<value::TypeTags, value::Value> FieldOffsetIndex::getField(const char* obj,
+                                                                    StringData name) {
+    if (obj == _obj && ++_numLookups >= kMinLookupsToIndex) {
+        if (!_indexed) {
+            buildIndex();
+        }
+        if (auto it = _elements.find(name); it != _elements.end()) {
+            return convertFrom<true>(it->second, _end, name.size());
+        }
+        return {value::TypeTags::Nothing, 0};
+    }
+
+    const auto end = bsonEnd(obj);
+    for (auto be = obj + 4; be != end - 1;) {
+        auto sv = fieldNameAndLength(be);
+        if (sv == name) {
+            return convertFrom<true>(be, end, sv.size());
+        }
+        be = advance(be, sv.size());
+    }
+    return {value::TypeTags::Nothing, 0};
+}
+
+void FieldOffsetIndex::buildIndex() {
+    _end = bsonEnd(_obj);
+    _elements.clear();
+    for (auto be = _obj + 4; be != _end - 1;) {
+        auto sv = fieldNameAndLength(be);
+        // Only the first occurrence of a name is kept, which is the one a linear search finds.
+        _elements.try_emplace(sv, be);
+        be = advance(be, sv.size());
+    }
+    _indexed = true;
+}
+}  // namespace bson
+}  // namespace sbe
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace sbe {
+namespace bson {
+/**
+ * Maps field names to element positions for the BSON object currently held by a plan stage, so
+ * that many field lookups on the same object do not each walk it from the beginning.
+ *
+ * Most objects are only searched a few times, and for those a linear walk is cheaper than building
+ * a hash table. The index is therefore only built once kMinLookupsToIndex lookups have hit the
+ * same object, and is then reused for the remaining lookups on it.
+ *
+ * The stage that owns the object calls reset() whenever it produces a new one, and clear() before
+ * the object may be released or moved. Compiled field lookups receive the index explicitly, see
+ * CompileCtx::fieldIndexes.
+ */
+class FieldOffsetIndex {
+public:
+    static constexpr size_t kMinLookupsToIndex = 4;
+
+    FieldOffsetIndex() = default;
+    FieldOffsetIndex(const FieldOffsetIndex&) = delete;
+    FieldOffsetIndex& operator=(const FieldOffsetIndex&) = delete;
+
+    /**
+     * Starts serving lookups on 'obj'. The index built for the previous object is dropped.
+     */
+    void reset(const char* obj) {
+        _obj = obj;
+        _numLookups = 0;
+        _indexed = false;
+    }
+
+    /**
+     * Stops serving lookups from this index until the next reset().
+     */
+    void clear() {
+        reset(nullptr);
+    }
+
+    /**
+     * Returns a view of the first element of 'obj' named 'name', or Nothing if there is none,
+     * exactly as a linear search of the object would. Only lookups on the object passed to reset()
+     * count towards building the index; any other object is searched linearly.
+     */
+    std::pair<value::TypeTags, value::Value> getField(const char* obj, StringData name);
+
+    bool isIndexed() const {
+        return _indexed;
+    }
+
+private:
+    void buildIndex();
+
+    const char* _obj = nullptr;
+    const char* _end = nullptr;
+
+    size_t _numLookups = 0;
+    bool _indexed = false;
+
+    // Maps each field name of '_obj' to its first element. The names point into '_obj'.
+    StringDataMap<const char*> _elements;
+};
+}  // namespace bson
+}  // namespace sbe
+}  // namespace mongo
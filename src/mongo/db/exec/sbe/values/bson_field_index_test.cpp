@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/unittest/assert.h"
+#include "mongo/unittest/framework.h"
+
+namespace mongo::sbe {
+namespace {
+
+// Looks up 'name' by walking 'obj' from the beginning, as the VM does without an index.
+std::pair<value::TypeTags, value::Value> linearGetField(const BSONObj& obj, StringData name) {
+    for (auto&& elem : obj) {
+        if (elem.fieldNameStringData() == name) {
+            return bson::convertFrom<true>(elem);
+        }
+    }
+    return {value::TypeTags::Nothing, 0};
+}
+
+void assertSameField(std::pair<value::TypeTags, value::Value> actual,
+                     std::pair<value::TypeTags, value::Value> expected) {
+    ASSERT_EQ(actual.first, expected.first);
+    if (expected.first == value::TypeTags::Nothing) {
+        return;
+    }
+    auto [cmpTag, cmpVal] =
+        value::compareValue(actual.first, actual.second, expected.first, expected.second);
+    ASSERT_EQ(cmpTag, value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(cmpVal), 0);
+}
+
+BSONObj makeWideObj(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    return bob.obj();
+}
+
+TEST(FieldOffsetIndexTest, LookupsMatchLinearSearch) {
+    auto obj = makeWideObj(200);
+    bson::FieldOffsetIndex index;
+    index.reset(obj.objdata());
+
+    // Look fields up out of order, repeat some and ask for missing ones, so that lookups are
+    // served both before and after the index is built.
+    for (auto name : {"f150", "f3", "f150", "f199", "missing", "f0", "f75", "missing", "f3"}) {
+        assertSameField(index.getField(obj.objdata(), name), linearGetField(obj, name));
+    }
+    ASSERT(index.isIndexed());
+}
+
+TEST(FieldOffsetIndexTest, IndexIsBuiltOnlyAfterEnoughLookups) {
+    auto obj = makeWideObj(10);
+    bson::FieldOffsetIndex index;
+    index.reset(obj.objdata());
+
+    for (size_t i = 1; i < bson::FieldOffsetIndex::kMinLookupsToIndex; ++i) {
+        index.getField(obj.objdata(), "f1");
+        ASSERT_FALSE(index.isIndexed());
+    }
+    index.getField(obj.objdata(), "f1");
+    ASSERT(index.isIndexed());
+}
+
+TEST(FieldOffsetIndexTest, DuplicateFieldsResolveToFirstOccurrence) {
+    auto obj = BSON("a" << 1 << "b" << 2 << "a" << 3 << "c" << 4 << "b" << 5);
+    bson::FieldOffsetIndex index;
+    index.reset(obj.objdata());
+
+    for (auto name : {"c", "a", "b", "a", "b", "c"}) {
+        assertSameField(index.getField(obj.objdata(), name), linearGetField(obj, name));
+    }
+    ASSERT(index.isIndexed());
+}
+
+TEST(FieldOffsetIndexTest, ResetStartsOverOnNewObject) {
+    auto first = BSON("a" << 1 << "b" << 2);
+    auto second = BSON("b" << 3 << "c" << 4);
+    bson::FieldOffsetIndex index;
+
+    index.reset(first.objdata());
+    for (size_t i = 0; i < bson::FieldOffsetIndex::kMinLookupsToIndex; ++i) {
+        index.getField(first.objdata(), "b");
+    }
+    ASSERT(index.isIndexed());
+
+    index.reset(second.objdata());
+    ASSERT_FALSE(index.isIndexed());
+    for (auto name : {"a", "b", "c", "a", "b", "c"}) {
+        assertSameField(index.getField(second.objdata(), name), linearGetField(second, name));
+    }
+}
+
+TEST(FieldOffsetIndexTest, OtherObjectsAreSearchedWithoutTheIndex) {
+    auto obj = BSON("a" << 1);
+    auto other = BSON("a" << 2 << "b" << 3);
+    bson::FieldOffsetIndex index;
+    index.reset(obj.objdata());
+
+    for (size_t i = 0; i < 2 * bson::FieldOffsetIndex::kMinLookupsToIndex; ++i) {
+        assertSameField(index.getField(other.objdata(), "b"), linearGetField(other, "b"));
+    }
+    ASSERT_FALSE(index.isIndexed());
+
+    index.clear();
+    for (size_t i = 0; i < 2 * bson::FieldOffsetIndex::kMinLookupsToIndex; ++i) {
+        assertSameField(index.getField(obj.objdata(), "a"), linearGetField(obj, "a"));
+    }
+    ASSERT_FALSE(index.isIndexed());
+}
+
+}  // namespace
+}  // namespace mongo::sbe
@@ -849,6 +849,7 @@ int getApproximateSize(TypeTags tag, Value val) {
         case TypeTags::sortSpec:
         case TypeTags::makeObjSpec:
         case TypeTags::indexBounds:
+        case TypeTags::orderStatisticTree:
             result += getExtendedTypeOps(tag)->getApproximateSize(val);
             break;
         default:
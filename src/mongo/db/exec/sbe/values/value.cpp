@@ -279,6 +279,7 @@ void releaseValueDeep(TypeTags tag, Value val) noexcept {
         case TypeTags::makeObjSpec:
         case TypeTags::indexBounds:
         case TypeTags::inList:
+        case TypeTags::orderStatisticTree:
             getExtendedTypeOps(tag)->release(val);
             break;
         default:
@@ -89,6 +89,7 @@ class TimeZoneDatabase;
 class TimeZone;
 
 class JsFunction;
+class OrderStatisticTree;
 
 namespace sbe {
 /**
@@ -244,6 +245,9 @@ enum class TypeTags : uint8_t {
     // Pointer to an InList object.
     inList,
 
+    // Pointer to an OrderStatisticTree object, the state of removable $percentile and $median.
+    orderStatisticTree,
+
     // Special marker, must be last.
     TypeTagsMax,
 };
@@ -1724,6 +1728,10 @@ inline IndexBounds* getIndexBoundsView(Value val) noexcept {
     return reinterpret_cast<IndexBounds*>(val);
 }
 
+inline OrderStatisticTree* getOrderStatisticTreeView(Value val) noexcept {
+    return reinterpret_cast<OrderStatisticTree*>(val);
+}
+
 inline SortKeyComponentVector* getSortKeyComponentVectorView(Value v) noexcept {
     return reinterpret_cast<SortKeyComponentVector*>(v);
 }
@@ -1944,6 +1952,7 @@ inline std::pair<TypeTags, Value> copyValue(TypeTags tag, Value val) {
         case TypeTags::makeObjSpec:
         case TypeTags::indexBounds:
         case TypeTags::inList:
+        case TypeTags::orderStatisticTree:
             return getExtendedTypeOps(tag)->makeCopy(val);
         case TypeTags::keyString:
             return {TypeTags::keyString,
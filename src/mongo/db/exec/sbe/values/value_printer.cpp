@@ -193,6 +193,9 @@ void ValuePrinter<T>::writeTagToStream(TypeTags tag) {
         case TypeTags::inList:
             stream << "inList";
             break;
+        case TypeTags::orderStatisticTree:
+            stream << "orderStatisticTree";
+            break;
         case TypeTags::sortKeyComponentVector:
             stream << "SortKeyComponentVector";
             break;
@@ -611,6 +614,7 @@ void ValuePrinter<T>::writeValueToStream(TypeTags tag, Value val, size_t depth)
         case TypeTags::makeObjSpec:
         case TypeTags::indexBounds:
         case TypeTags::inList:
+        case TypeTags::orderStatisticTree:
             stream << getExtendedTypeOps(tag)->print(val);
             break;
         default:
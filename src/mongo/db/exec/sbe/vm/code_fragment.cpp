@@ -603,6 +603,29 @@ void CodeFragment::appendGetField(Instruction::Parameter input, StringData field
     adjustStackSimple(i, input);
 }
 
+void CodeFragment::appendGetField(Instruction::Parameter input,
+                                  StringData fieldName,
+                                  bson::FieldOffsetIndex* fieldIndex) {
+    auto size = fieldName.size();
+    invariant(size < Instruction::kMaxInlineStringSize);
+
+    Instruction i;
+    i.tag = Instruction::getFieldImmIndexed;
+
+    auto offset = allocateSpace(sizeof(Instruction) + input.size() + sizeof(fieldIndex) +
+                                sizeof(uint8_t) + size);
+
+    offset += writeToMemory(offset, i);
+    offset += appendParameters(offset, input);
+    offset += writeToMemory(offset, fieldIndex);
+    offset += writeToMemory(offset, static_cast<uint8_t>(size));
+    for (auto ch : fieldName) {
+        offset += writeToMemory(offset, ch);
+    }
+
+    adjustStackSimple(i, input);
+}
+
 void CodeFragment::appendGetElement(Instruction::Parameter lhs, Instruction::Parameter rhs) {
     appendSimpleInstruction(Instruction::getElement, lhs, rhs);
 }
@@ -123,6 +123,9 @@ public:
     void appendFillEmpty(Instruction::Constants k);
     void appendGetField(Instruction::Parameter lhs, Instruction::Parameter rhs);
     void appendGetField(Instruction::Parameter input, StringData fieldName);
+    void appendGetField(Instruction::Parameter input,
+                        StringData fieldName,
+                        bson::FieldOffsetIndex* fieldIndex);
     void appendGetElement(Instruction::Parameter lhs, Instruction::Parameter rhs);
     void appendCollComparisonKey(Instruction::Parameter lhs, Instruction::Parameter rhs);
     void appendGetFieldOrElement(Instruction::Parameter lhs, Instruction::Parameter rhs);
@@ -32,6 +32,7 @@
 #include "mongo/config.h"  // IWYU pragma: keep
 #include "mongo/db/exec/sbe/accumulator_sum_value_enum.h"
 #include "mongo/db/exec/sbe/values/arith_common.h"
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
 #include "mongo/db/exec/sbe/values/util.h"
 
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
@@ -95,6 +96,18 @@ FastTuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTag
     return {false, value::TypeTags::Nothing, 0};
 }
 
+FastTuple<bool, value::TypeTags, value::Value> ByteCode::getField(
+    value::TypeTags objTag,
+    value::Value objValue,
+    StringData fieldStr,
+    bson::FieldOffsetIndex& fieldIndex) {
+    if (objTag == value::TypeTags::bsonObject) {
+        auto [tag, val] = fieldIndex.getField(value::bitcastTo<const char*>(objValue), fieldStr);
+        return {false, tag, val};
+    }
+    return getField(objTag, objValue, fieldStr);
+}
+
 FastTuple<bool, value::TypeTags, value::Value> ByteCode::getElement(value::TypeTags arrTag,
                                                                     value::Value arrValue,
                                                                     value::TypeTags idxTag,
@@ -52,6 +52,7 @@
 #include "mongo/config.h"  // IWYU pragma: keep
 #include "mongo/db/exec/sbe/sort_spec.h"
 #include "mongo/db/exec/sbe/values/block_interface.h"
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
 #include "mongo/db/exec/sbe/values/column_op.h"
 #include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/exec/sbe/values/value.h"
@@ -470,6 +471,11 @@ private:
                                                             value::Value objValue,
                                                             StringData fieldStr);
 
+    FastTuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                            value::Value objValue,
+                                                            StringData fieldStr,
+                                                            bson::FieldOffsetIndex& fieldIndex);
+
     FastTuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                               value::Value objValue,
                                                               value::TypeTags fieldTag,
@@ -1164,6 +1170,12 @@ private:
     template <TopBottomSense>
     FastTuple<bool, value::TypeTags, value::Value> builtinAggRemovableTopBottomNFinalize(
         ArityType arity);
+    FastTuple<bool, value::TypeTags, value::Value> builtinAggRemovablePercentileAdd(
+        ArityType arity);
+    FastTuple<bool, value::TypeTags, value::Value> builtinAggRemovablePercentileRemove(
+        ArityType arity);
+    FastTuple<bool, value::TypeTags, value::Value> builtinAggRemovablePercentileFinalize(
+        ArityType arity);
 
     // Block builtins
 
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/sbe/expressions/compile_ctx.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/expressions/runtime_environment.h"
+#include "mongo/db/exec/sbe/values/bson_field_index.h"
 #include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
@@ -94,6 +95,121 @@ public:
         }
     }
 
+    /**
+     * Slides a ["current", 'windowSize' - 1] window over 'inputs' the way a removable
+     * $setWindowFields window does: the first window adds 'windowSize' inputs, and every following
+     * one removes the previous document, adds the next one if there is one, and finalizes.
+     */
+    void benchmarkRemovableWindow(const EExpression& add,
+                                  const EExpression& remove,
+                                  const EExpression& finalize,
+                                  value::SlotId aggSlotId,
+                                  const std::vector<TagValue>& inputs,
+                                  size_t windowSize,
+                                  benchmark::State& state) {
+        auto aggAccessor = _env->getAccessor(aggSlotId);
+        vm::CodeFragment addCode = compileAggExpression(add, aggAccessor);
+        vm::CodeFragment removeCode = compileAggExpression(remove, aggAccessor);
+        vm::CodeFragment finalizeCode = finalize.compileDirect(_compileCtx);
+        vm::ByteCode vm;
+        auto inputAccessor = _env->getAccessor(_inputSlotId);
+
+        auto runAgg = [&](vm::CodeFragment* code, TagValue input) {
+            inputAccessor->reset(false, input.first, input.second);
+            auto [owned, tag, val] = vm.run(code);
+            aggAccessor->reset(owned, tag, val);
+        };
+
+        for (auto keepRunning : state) {
+            aggAccessor->reset(false, value::TypeTags::Nothing, 0);
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                if (i == 0) {
+                    for (size_t j = 0; j < windowSize && j < inputs.size(); ++j) {
+                        runAgg(&addCode, inputs[j]);
+                    }
+                } else {
+                    runAgg(&removeCode, inputs[i - 1]);
+                    if (i + windowSize - 1 < inputs.size()) {
+                        runAgg(&addCode, inputs[i + windowSize - 1]);
+                    }
+                }
+                auto [owned, tag, val] = vm.run(&finalizeCode);
+                if (owned) {
+                    value::releaseValue(tag, val);
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        aggAccessor->reset(false, value::TypeTags::Nothing, 0);
+    }
+
+    /**
+     * Reads 'numLookups' fields of records with 'numFields' fields each, the way the expressions
+     * of a plan read the record slot of a scan. When 'indexed' is true the lookups are compiled
+     * against a FieldOffsetIndex that is reset for every record, as the scan does.
+     */
+    void benchmarkRecordFieldLookups(size_t numFields,
+                                     size_t numLookups,
+                                     bool indexed,
+                                     benchmark::State& state) {
+        constexpr size_t kNumRecords = 1000;
+        std::vector<BSONObj> records;
+        records.reserve(kNumRecords);
+        for (size_t i = 0; i < kNumRecords; ++i) {
+            BSONObjBuilder bob;
+            for (size_t j = 0; j < numFields; ++j) {
+                bob.append("field" + std::to_string(j), static_cast<long long>(i + j));
+            }
+            records.push_back(bob.obj());
+        }
+
+        value::OwnedValueAccessor recordAccessor;
+        bson::FieldOffsetIndex fieldIndex;
+        auto recordSlot = _slotIdGenerator.generate();
+        _compileCtx.pushCorrelated(recordSlot, &recordAccessor);
+        if (indexed) {
+            _compileCtx.fieldIndexes[&recordAccessor] = &fieldIndex;
+        }
+
+        // Spread the lookups evenly over the record.
+        std::vector<vm::CodeFragment> lookups;
+        for (size_t i = 0; i < numLookups; ++i) {
+            auto name = "field" + std::to_string((2 * i + 1) * numFields / (2 * numLookups));
+            auto expr = makeE<EFunction>(
+                "getField"_sd, makeEs(makeE<EVariable>(recordSlot), makeE<EConstant>(name)));
+            lookups.push_back(expr->compileDirect(_compileCtx));
+        }
+        _compileCtx.fieldIndexes.clear();
+        _compileCtx.popCorrelated();
+
+        vm::ByteCode vm;
+        for (auto keepRunning : state) {
+            for (const auto& record : records) {
+                recordAccessor.reset(false,
+                                     value::TypeTags::bsonObject,
+                                     value::bitcastFrom<const char*>(record.objdata()));
+                fieldIndex.reset(record.objdata());
+                for (auto& code : lookups) {
+                    auto [owned, tag, val] = vm.run(&code);
+                    if (owned) {
+                        value::releaseValue(tag, val);
+                    }
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+    }
+
+    std::vector<TagValue> generateRandomDoubles(size_t count) {
+        std::vector<TagValue> doubles;
+        doubles.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            doubles.push_back({value::TypeTags::NumberDouble,
+                               value::bitcastFrom<double>(_random.nextCanonicalDouble())});
+        }
+        return doubles;
+    }
+
     TagValue generateRandomString(size_t size) {
         static const std::string kAlphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
         std::string str;
@@ -150,11 +266,24 @@ public:
         return _inputSlotId;
     }
 
+    value::SlotId registerAggSlot(StringData name) {
+        return _env->registerSlot(name, value::TypeTags::Nothing, 0, false, &_slotIdGenerator);
+    }
+
     PseudoRandom random() const {
         return _random;
     }
 
 private:
+    vm::CodeFragment compileAggExpression(const EExpression& expr, value::SlotAccessor* accessor) {
+        _compileCtx.aggExpression = true;
+        _compileCtx.accumulator = accessor;
+        vm::CodeFragment code = expr.compileDirect(_compileCtx);
+        _compileCtx.aggExpression = false;
+        _compileCtx.accumulator = nullptr;
+        return code;
+    }
+
     SbeVmBenchmark(std::unique_ptr<RuntimeEnvironment> env)
         : _env(env.get()), _compileCtx(std::move(env)), _random(kSeed) {
         _env->registerSlot("timeZoneDB"_sd,
@@ -207,6 +336,40 @@ BENCHMARK_DEFINE_F(SbeVmBenchmark, BM_IsMember_ArraySet_Collator)(benchmark::Sta
     benchmarkExpression(std::move(expr), {searchValue}, state);
 }
 
+// The SBE counterpart of WindowFunctionPercentileBenchmarkFixture::removable_bounded_percentile.
+// The argument is the number of percentiles requested.
+BENCHMARK_DEFINE_F(SbeVmBenchmark, BM_RemovablePercentile_Bounded)(benchmark::State& state) {
+    constexpr size_t kNumInputs = 100'000;
+    constexpr size_t kWindowSize = 101;
+    auto inputs = generateRandomDoubles(kNumInputs);
+
+    auto [psTag, psVal] = value::makeNewArray();
+    auto ps = value::getArrayView(psVal);
+    for (int64_t i = 1; i <= state.range(0); ++i) {
+        ps->push_back(value::TypeTags::NumberDouble,
+                      value::bitcastFrom<double>(static_cast<double>(i) / (state.range(0) + 1)));
+    }
+
+    auto aggSlot = registerAggSlot("percentileState"_sd);
+    auto add = makeE<EFunction>("aggRemovablePercentileAdd"_sd,
+                                makeEs(makeE<EVariable>(inputSlotId())));
+    auto remove = makeE<EFunction>("aggRemovablePercentileRemove"_sd,
+                                   makeEs(makeE<EVariable>(inputSlotId())));
+    auto finalize =
+        makeE<EFunction>("aggRemovablePercentileFinalize"_sd,
+                         makeEs(makeE<EVariable>(aggSlot), makeE<EConstant>(psTag, psVal)));
+    benchmarkRemovableWindow(*add, *remove, *finalize, aggSlot, inputs, kWindowSize, state);
+}
+
+// The arguments are the number of fields in each record and the number of fields read from it.
+BENCHMARK_DEFINE_F(SbeVmBenchmark, BM_GetField_Record)(benchmark::State& state) {
+    benchmarkRecordFieldLookups(state.range(0), state.range(1), false /* indexed */, state);
+}
+
+BENCHMARK_DEFINE_F(SbeVmBenchmark, BM_GetField_Record_Indexed)(benchmark::State& state) {
+    benchmarkRecordFieldLookups(state.range(0), state.range(1), true /* indexed */, state);
+}
+
 #define ADD_ARGS()        \
     Args({5, 5})          \
         ->Args({10, 5})   \
@@ -222,5 +385,13 @@ BENCHMARK_REGISTER_F(SbeVmBenchmark, BM_IsMember_ArraySet_NoCollator)->Args({100
 
 BENCHMARK_REGISTER_F(SbeVmBenchmark, BM_IsMember_ArraySet_Collator)->ADD_ARGS();
 
+BENCHMARK_REGISTER_F(SbeVmBenchmark, BM_RemovablePercentile_Bounded)->Arg(1)->Arg(10);
+
+#define GET_FIELD_ARGS() Args({10, 2})->Args({10, 10})->Args({200, 2})->Args({200, 20})
+
+BENCHMARK_REGISTER_F(SbeVmBenchmark, BM_GetField_Record)->GET_FIELD_ARGS();
+
+BENCHMARK_REGISTER_F(SbeVmBenchmark, BM_GetField_Record_Indexed)->GET_FIELD_ARGS();
+
 }  // namespace
 }  // namespace mongo::sbe
@@ -527,6 +527,12 @@ std::string builtinToString(Builtin b) {
             return "aggRemovableBottomNRemove";
         case Builtin::aggRemovableBottomNFinalize:
             return "aggRemovableBottomNFinalize";
+        case Builtin::aggRemovablePercentileAdd:
+            return "aggRemovablePercentileAdd";
+        case Builtin::aggRemovablePercentileRemove:
+            return "aggRemovablePercentileRemove";
+        case Builtin::aggRemovablePercentileFinalize:
+            return "aggRemovablePercentileFinalize";
         case Builtin::valueBlockTypeMatch:
             return "valueBlockTypeMatch";
         case Builtin::valueBlockIsTimezone:
@@ -1115,6 +1121,12 @@ FastTuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builtin
             return builtinAggRemovableTopBottomNFinalize<TopBottomSense::kTop>(arity);
         case Builtin::aggRemovableBottomNFinalize:
             return builtinAggRemovableTopBottomNFinalize<TopBottomSense::kBottom>(arity);
+        case Builtin::aggRemovablePercentileAdd:
+            return builtinAggRemovablePercentileAdd(arity);
+        case Builtin::aggRemovablePercentileRemove:
+            return builtinAggRemovablePercentileRemove(arity);
+        case Builtin::aggRemovablePercentileFinalize:
+            return builtinAggRemovablePercentileFinalize(arity);
         case Builtin::aggLinearFillCanAdd:
             return builtinAggLinearFillCanAdd(arity);
         case Builtin::aggLinearFillAdd:
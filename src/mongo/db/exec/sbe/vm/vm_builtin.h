@@ -332,6 +332,9 @@ enum class Builtin : uint16_t {
     aggRemovableBottomNAdd,
     aggRemovableBottomNRemove,
     aggRemovableBottomNFinalize,
+    aggRemovablePercentileAdd,
+    aggRemovablePercentileRemove,
+    aggRemovablePercentileFinalize,
 
     // Additional one-byte builtins go here.
 
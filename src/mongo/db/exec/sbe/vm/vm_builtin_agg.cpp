@@ -31,6 +31,8 @@
 #include "mongo/db/exec/sbe/values/util.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/db/exec/sbe/vm/vm_datetime.h"
+#include "mongo/db/pipeline/percentile_algo_discrete.h"
+#include "mongo/db/pipeline/window_function/order_statistic_tree.h"
 
 namespace mongo {
 namespace sbe {
@@ -3666,6 +3668,85 @@ ByteCode::builtinAggRemovableTopBottomNFinalize<(TopBottomSense)0>(ArityType ari
 template FastTuple<bool, value::TypeTags, value::Value>
 ByteCode::builtinAggRemovableTopBottomNFinalize<(TopBottomSense)1>(ArityType arity);
 
+namespace {
+OrderStatisticTree& removablePercentileTree(value::TypeTags stateTag, value::Value stateVal) {
+    tassert(10745800,
+            "state should be of type orderStatisticTree",
+            stateTag == value::TypeTags::orderStatisticTree);
+    return *value::getOrderStatisticTreeView(stateVal);
+}
+}  // namespace
+
+FastTuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggRemovablePercentileAdd(
+    ArityType arity) {
+    auto [stateTag, stateVal] = moveOwnedFromStack(0);
+    if (stateTag == value::TypeTags::Nothing) {
+        stateTag = value::TypeTags::orderStatisticTree;
+        stateVal = value::bitcastFrom<OrderStatisticTree*>(new OrderStatisticTree());
+    }
+    value::ValueGuard stateGuard{stateTag, stateVal};
+    auto [_, inputTag, inputVal] = getFromStack(1);
+
+    // Only numeric values take part in the percentile. They are kept as doubles in a tree ordered
+    // by value, so that both sliding the window and reading any rank take logarithmic time.
+    if (value::isNumber(inputTag)) {
+        auto input = value::bitcastTo<double>(value::coerceToDouble(inputTag, inputVal).second);
+        removablePercentileTree(stateTag, stateVal).insert(input);
+    }
+
+    stateGuard.reset();
+    return {true, stateTag, stateVal};
+}
+
+FastTuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggRemovablePercentileRemove(
+    ArityType arity) {
+    auto [stateTag, stateVal] = moveOwnedFromStack(0);
+    value::ValueGuard stateGuard{stateTag, stateVal};
+    auto [_, inputTag, inputVal] = getFromStack(1);
+
+    auto& tree = removablePercentileTree(stateTag, stateVal);
+
+    if (value::isNumber(inputTag)) {
+        auto input = value::bitcastTo<double>(value::coerceToDouble(inputTag, inputVal).second);
+        tassert(10745801,
+                "Cannot remove a value not tracked by the removable percentile state",
+                tree.erase(input));
+    }
+
+    stateGuard.reset();
+    return {true, stateTag, stateVal};
+}
+
+FastTuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggRemovablePercentileFinalize(
+    ArityType arity) {
+    auto [stateOwned, stateTag, stateVal] = getFromStack(0);
+    auto [psOwned, psTag, psVal] = getFromStack(1);
+
+    const auto& tree = removablePercentileTree(stateTag, stateVal);
+    tassert(10745802, "percentiles should be of type Array", psTag == value::TypeTags::Array);
+    auto ps = value::getArrayView(psVal);
+
+    auto [resTag, resVal] = value::makeNewArray();
+    value::ValueGuard resGuard{resTag, resVal};
+    auto resArr = value::getArrayView(resVal);
+    resArr->reserve(ps->size());
+
+    for (size_t i = 0; i < ps->size(); ++i) {
+        if (tree.empty()) {
+            resArr->push_back(value::TypeTags::Null, 0);
+            continue;
+        }
+        auto [pTag, pVal] = ps->getAt(i);
+        auto p = value::bitcastTo<double>(value::coerceToDouble(pTag, pVal).second);
+        auto rank = DiscretePercentile::computeTrueRank(tree.size(), p);
+        resArr->push_back(value::TypeTags::NumberDouble,
+                          value::bitcastFrom<double>(tree.select(rank)));
+    }
+
+    resGuard.reset();
+    return {true, resTag, resVal};
+}
+
 }  // namespace vm
 }  // namespace sbe
 }  // namespace mongo
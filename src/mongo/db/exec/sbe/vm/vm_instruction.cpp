@@ -121,6 +121,7 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     0,   // fillEmptyImm
     -1,  // getField
     0,   // getFieldImm
+    0,   // getFieldImmIndexed
     -1,  // getElement
     -1,  // collComparisonKey
     -1,  // getFieldOrElement
@@ -869,6 +870,30 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                 pushStack(owned, tag, val);
                 break;
             }
+            case Instruction::getFieldImmIndexed: {
+                auto [popLhs, moveFromLhs, offsetLhs] =
+                    Instruction::Parameter::decodeParam(pcPointer);
+                auto fieldIndex = readFromMemory<bson::FieldOffsetIndex*>(pcPointer);
+                pcPointer += sizeof(fieldIndex);
+                auto size = readFromMemory<uint8_t>(pcPointer);
+                pcPointer += sizeof(size);
+                StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                pcPointer += size;
+
+                auto [lhsOwned, lhsTag, lhsVal] = getFromStack(offsetLhs, popLhs);
+                value::ValueGuard lhsGuard(lhsOwned && popLhs, lhsTag, lhsVal);
+
+                auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldName, *fieldIndex);
+
+                // Copy value only if needed
+                if (lhsOwned && !owned) {
+                    owned = true;
+                    std::tie(tag, val) = value::copyValue(tag, val);
+                }
+
+                pushStack(owned, tag, val);
+                break;
+            }
             case Instruction::getElement: {
                 auto [popLhs, moveFromLhs, offsetLhs] =
                     Instruction::Parameter::decodeParam(pcPointer);
@@ -1535,6 +1560,8 @@ const char* Instruction::toString() const {
             return "getField";
         case getFieldImm:
             return "getFieldImm";
+        case getFieldImmIndexed:
+            return "getFieldImmIndexed";
         case getElement:
             return "getElement";
         case collComparisonKey:
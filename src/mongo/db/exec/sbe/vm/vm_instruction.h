@@ -98,6 +98,7 @@ struct Instruction {
         fillEmptyImm,
         getField,
         getFieldImm,
+        getFieldImmIndexed,
         getElement,
         collComparisonKey,
         getFieldOrElement,
@@ -305,6 +305,19 @@ public:
                        << ", offsetParam: " << offsetParam << ", value: \"" << fieldName << "\"";
                     break;
                 }
+                case Instruction::getFieldImmIndexed: {
+                    auto [popParam, moveFromParam, offsetParam] =
+                        Instruction::Parameter::decodeParam(pcPointer);
+                    pcPointer += sizeof(bson::FieldOffsetIndex*);
+                    auto size = readFromMemory<uint8_t>(pcPointer);
+                    pcPointer += sizeof(size);
+                    StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                    pcPointer += size;
+
+                    os << "popParam: " << popParam << ", moveFromParam: " << moveFromParam
+                       << ", offsetParam: " << offsetParam << ", value: \"" << fieldName << "\"";
+                    break;
+                }
                 case Instruction::pushConstVal: {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
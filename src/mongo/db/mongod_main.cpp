@@ -136,6 +136,7 @@
 #include "mongo/db/pipeline/change_stream_expired_pre_image_remover.h"
 #include "mongo/db/pipeline/change_stream_preimage_gen.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
+#include "mongo/db/pipeline/writer_util.h"
 #include "mongo/db/profile_filter_impl.h"
 #include "mongo/db/query/client_cursor/clientcursor.h"
 #include "mongo/db/query/query_knobs_gen.h"
@@ -1984,6 +1985,16 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         shutdownChangeCollectionExpiredDocumentsRemover(serviceContext);
     }
 
+    // Background $out and $merge flushes were interrupted by killing all operations above, and
+    // must not outlive the storage engine.
+    {
+        TimeElapsedBuilderScopedTimer scopedTimer(serviceContext->getFastClockSource(),
+                                                  "Shut down the writer flush pool",
+                                                  &shutdownTimeElapsedBuilder);
+        LOGV2_OPTIONS(10745812, {LogComponent::kQuery}, "Shutting down the writer flush pool");
+        shutdownWriterFlushPool(serviceContext);
+    }
+
     {
         TimeElapsedBuilderScopedTimer scopedTimer(
             serviceContext->getFastClockSource(),
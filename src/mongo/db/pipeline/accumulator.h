@@ -45,6 +45,7 @@
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/hyper_log_log.h"
 #include "mongo/db/query/query_shape/serialization_options.h"
 #include "mongo/db/query/stats/stats_gen.h"
 #include "mongo/db/query/stats/value_utils.h"
@@ -220,6 +221,39 @@ private:
     ValueFlatUnorderedSet _set;
 };
 
+/**
+ * Estimates the number of distinct values, as compared under the collation of the expression
+ * context, with a HyperLogLog sketch. Unlike $addToSet followed by $size, the partial results
+ * passed between shards and the merging node have a bounded size regardless of the cardinality.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    static constexpr auto kName = "$approxCountDistinct"_sd;
+
+    const char* getOpName() const final {
+        return kName.rawData();
+    }
+
+    explicit AccumulatorApproxCountDistinct(ExpressionContext* expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* expCtx);
+
+    ExpressionNary::Associativity getAssociativity() const final {
+        return ExpressionNary::Associativity::kFull;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    HyperLogLog _sketch;
+};
+
 class AccumulatorFirst final : public AccumulatorState {
 public:
     static constexpr auto kName = "$first"_sd;
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include "mongo/base/data_range.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/storage/key_string/key_string.h"
+#include "mongo/util/intrusive_counter.h"
+#include "mongo/util/murmur3.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_UNSTABLE_ACCUMULATOR_WITH_FEATURE_FLAG(
+    approxCountDistinct,
+    genericParseSBEUnsupportedSingleExpressionAccumulator<AccumulatorApproxCountDistinct>,
+    feature_flags::gFeatureFlagApproxCountDistinct);
+
+namespace {
+/**
+ * Hashes 'input' so that values which compare equal under 'collator' get the same hash. The
+ * sketches of different nodes are merged, so the hash must not depend on the process, which rules
+ * out Value::hash_combine(). KeyString encodes equal values, such as equal numbers of different
+ * types, with the same bytes.
+ */
+uint64_t hashForSketch(const Value& input, const CollatorInterface* collator) {
+    BSONObjBuilder bob;
+    input.addToBsonObj(&bob, ""_sd);
+
+    key_string::StringTransformFn transform;
+    if (collator) {
+        transform = [collator](StringData str) {
+            return collator->getComparisonString(str);
+        };
+    }
+    key_string::Builder ks(key_string::Version::kLatestVersion);
+    ks.appendBSONElement(bob.done().firstElement(), transform);
+    return murmur3<sizeof(uint64_t)>(ConstDataRange(ks.getBuffer(), ks.getSize()), 0 /*seed*/);
+}
+}  // namespace
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (merging) {
+        _sketch.combine(input);
+    } else if (!input.missing()) {
+        _sketch.add(hashForSketch(input, getExpressionContext()->getCollator()));
+    }
+    _memUsageTracker.set(sizeof(*this) - sizeof(_sketch) + _sketch.memUsageBytes());
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        return _sketch.serialize();
+    }
+    return Value(_sketch.estimate());
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(ExpressionContext* const expCtx)
+    : AccumulatorState(expCtx) {
+    _memUsageTracker.set(sizeof(*this));
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _sketch.reset();
+    _memUsageTracker.set(sizeof(*this));
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    ExpressionContext* const expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+}  // namespace mongo
@@ -1782,6 +1782,76 @@ TEST(Accumulators, AddToSetRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST(Accumulators, ApproxCountDistinct) {
+    auto expCtx = ExpressionContextForTest{};
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx,
+        {// No documents evaluated.
+         {{}, Value(0LL)},
+         // Missing values are not counted, but null is.
+         {{Value(), Value(BSONNULL)}, Value(1LL)},
+         // Equal numbers of different types are counted once.
+         {{Value(1), Value(1.0), Value(1LL), Value(Decimal128(1)), Value(2)}, Value(2LL)},
+         // Arrays and documents are counted as a whole.
+         {{Value(std::vector<Value>{Value(1), Value(2)}),
+           Value(std::vector<Value>{Value(1), Value(2)}),
+           Value(std::vector<Value>{Value(2), Value(1)}),
+           Value(Document{{"a", 1}}),
+           Value(Document{{"a", 1.0}})},
+          Value(3LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    auto collator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx.setCollator(std::move(collator));
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctMergesShardSketches) {
+    auto expCtx = ExpressionContextForTest{};
+
+    // Shards 1 to 3 each see 40'000 values, half of which are also seen by the next shard. Shard 0
+    // sees only 100 values of its own so that its sketch stays sparse, and is merged into a dense
+    // sketch. The merged count must be close to the 80'100 distinct values overall.
+    const int numShards = 4;
+    const int numValuesPerShard = 40'000;
+    auto merger = AccumulatorApproxCountDistinct::create(&expCtx);
+    for (int shard : {1, 0, 2, 3}) {
+        auto shardAcc = AccumulatorApproxCountDistinct::create(&expCtx);
+        const int numValues = shard == 0 ? 100 : numValuesPerShard;
+        for (int i = 0; i < numValues; ++i) {
+            shardAcc->process(Value(shard * numValuesPerShard / 2 + i), false);
+        }
+
+        auto partial = shardAcc->getValue(true);
+        ASSERT_EQ(partial.getType(), BinData);
+        ASSERT_LTE(partial.getBinData().length, 2 + static_cast<int>(HyperLogLog::kNumRegisters));
+        merger->process(partial, true);
+    }
+
+    const double expected = 100 + numShards * numValuesPerShard / 2;
+    auto estimate = merger->getValue(false);
+    ASSERT_EQ(estimate.getType(), NumberLong);
+    ASSERT_APPROX_EQUAL(estimate.getLong(), expected, expected * 0.03);
+}
+
+TEST(HyperLogLog, EstimatesCardinalityWithinErrorBound) {
+    PseudoRandom random(0x5eed);
+    for (long long cardinality : {1'000LL, 5'000LL, 20'000LL, 1'000'000LL}) {
+        HyperLogLog sketch;
+        for (long long i = 0; i < cardinality; ++i) {
+            // Each hash is added twice, which must not change the estimate.
+            auto hash = static_cast<uint64_t>(random.nextInt64());
+            sketch.add(hash);
+            sketch.add(hash);
+        }
+        ASSERT_APPROX_EQUAL(sketch.estimate(), cardinality, cardinality * 0.03);
+    }
+}
+
 TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
     auto expCtx = ExpressionContextForTest{};
     const int maxMemoryBytes = 20ull;
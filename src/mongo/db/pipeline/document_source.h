@@ -477,7 +477,10 @@ public:
 
         ++_commonStats.works;
 
+        const auto documentAllocationsBefore = DocumentStorage::threadCacheBufferAcquisitions();
         GetNextResult next = doGetNext();
+        _commonStats.documentAllocations +=
+            DocumentStorage::threadCacheBufferAcquisitions() - documentAllocationsBefore;
         if (next.isAdvanced()) {
             ++_commonStats.advanced;
         }
@@ -34,6 +34,7 @@
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <deque>
@@ -49,6 +50,7 @@
 #include "mongo/db/pipeline/expression_dependencies.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/query/allowed_contexts.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/sorter/sorter_stats.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/assert_util.h"
@@ -116,10 +118,22 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::doGetNext() {
         }
         invariant(populationResult.isEOF());
 
-        initializeBucketIteration();
+        if (_quantileSketch) {
+            initializeApproximateBuckets();
+        } else {
+            initializeBucketIteration();
+        }
         _populated = true;
     }
 
+    if (_quantileSketch) {
+        if (_nextApproximateBucket < _approximateBuckets.size()) {
+            return makeDocument(_approximateBuckets[_nextApproximateBucket++]);
+        }
+        dispose();
+        return GetNextResult::makeEOF();
+    }
+
     if (!_sortedInput) {
         // We have been disposed. Return EOF.
         return GetNextResult::makeEOF();
@@ -169,20 +183,30 @@ void DocumentSourceBucketAuto::addVariableRefs(std::set<Variables::Id>* refs) co
     }
 }
 
+std::unique_ptr<Sorter<Value, Document>> DocumentSourceBucketAuto::makeSorter() const {
+    SortOptions opts;
+    opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    if (pExpCtx->getAllowDiskUse() && !pExpCtx->getInRouter()) {
+        opts.extSortAllowed = true;
+        opts.tempDir = pExpCtx->getTempDir();
+    }
+    const auto& valueCmp = pExpCtx->getValueComparator();
+    auto comparator = [valueCmp](const Value& lhs, const Value& rhs) {
+        return valueCmp.compare(lhs, rhs);
+    };
+
+    return std::unique_ptr<Sorter<Value, Document>>(
+        Sorter<Value, Document>::make(opts, comparator));
+}
+
 DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
-    if (!_sorter) {
-        SortOptions opts;
-        opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
-        if (pExpCtx->getAllowDiskUse() && !pExpCtx->getInRouter()) {
-            opts.extSortAllowed = true;
-            opts.tempDir = pExpCtx->getTempDir();
+    if (!_sorter && !_quantileSketch) {
+        // A granularity moves the boundaries found for the buckets, which needs the sorted input.
+        if (!_granularityRounder && internalQueryBucketAutoUseQuantileSketch.load()) {
+            _quantileSketch = std::make_unique<ValueQuantileSketch>(pExpCtx->getValueComparator());
+        } else {
+            _sorter = makeSorter();
         }
-        const auto& valueCmp = pExpCtx->getValueComparator();
-        auto comparator = [valueCmp](const Value& lhs, const Value& rhs) {
-            return valueCmp.compare(lhs, rhs);
-        };
-
-        _sorter.reset(Sorter<Value, Document>::make(opts, comparator));
     }
 
     long long position = 0;
@@ -193,12 +217,35 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
 
         auto doc = Document{{AccumulatorN::kFieldNameOutput, Value(std::move(nextDoc))},
                             {AccumulatorN::kFieldNameGeneratedSortKey, Value(position++)}};
-        _sorter->add(std::move(key), std::move(doc));
+        if (_quantileSketch) {
+            addToQuantileSketch(std::move(key), std::move(doc));
+        } else {
+            _sorter->add(std::move(key), std::move(doc));
+        }
         ++_nDocuments;
     }
     return next;
 }
 
+void DocumentSourceBucketAuto::addToQuantileSketch(Value key, Document doc) {
+    _bufferedInputBytes += key.getApproximateSize() + doc.getApproximateSize();
+    _quantileSketch->add(key);
+    _bufferedInput.emplace_back(std::move(key), std::move(doc));
+
+    if (_bufferedInputBytes + _quantileSketch->memUsageBytes() > _maxMemoryUsageBytes) {
+        // The sorter can spill to disk, so hand everything buffered so far over to it and carry on
+        // with the exact algorithm.
+        _sorter = makeSorter();
+        for (auto&& [bufferedKey, bufferedDoc] : _bufferedInput) {
+            _sorter->add(std::move(bufferedKey), std::move(bufferedDoc));
+        }
+        _bufferedInput.clear();
+        _bufferedInput.shrink_to_fit();
+        _bufferedInputBytes = 0;
+        _quantileSketch.reset();
+    }
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -234,7 +281,11 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
                                                    Bucket& bucket) {
     invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
     bucket._max = entry.first;
+    accumulateDocument(entry, bucket);
+}
 
+void DocumentSourceBucketAuto::accumulateDocument(const pair<Value, Document>& entry,
+                                                  Bucket& bucket) {
     const size_t numAccumulators = _accumulatedFields.size();
     for (size_t k = 0; k < numAccumulators; k++) {
         if (bucket._accums[k]->needsInput()) {
@@ -279,6 +330,62 @@ void DocumentSourceBucketAuto::initializeBucketIteration() {
     }
 }
 
+void DocumentSourceBucketAuto::initializeApproximateBuckets() {
+    const auto& valueCmp = pExpCtx->getValueComparator();
+
+    // Split the 'groupBy' values at their approximate j/n-quantiles. There is no point in asking
+    // for more splits than there are documents. Equal quantiles are collapsed so that documents
+    // with equal 'groupBy' values always land in the same bucket.
+    const long long numSplits = std::min<long long>(_nBuckets, _nDocuments) - 1;
+    std::vector<double> fractions;
+    fractions.reserve(std::max(numSplits, 0LL));
+    for (long long j = 1; j <= numSplits; ++j) {
+        fractions.push_back(double(j) / double(numSplits + 1));
+    }
+    auto boundaries = _quantileSketch->quantiles(fractions);
+    boundaries.erase(std::unique(boundaries.begin(),
+                                 boundaries.end(),
+                                 [&](const Value& lhs, const Value& rhs) {
+                                     return valueCmp.evaluate(lhs == rhs);
+                                 }),
+                     boundaries.end());
+
+    // Bucket 'i' holds the values in (boundaries[i - 1], boundaries[i]]. Like the exact algorithm,
+    // this keeps a run of duplicates of a boundary value in the bucket which reached it first.
+    std::vector<boost::optional<Bucket>> buckets(boundaries.size() + 1);
+    const auto lessThan = valueCmp.getLessThan();
+    for (auto&& entry : _bufferedInput) {
+        const auto index =
+            std::lower_bound(boundaries.begin(), boundaries.end(), entry.first, lessThan) -
+            boundaries.begin();
+        auto& bucket = buckets[index];
+        if (!bucket) {
+            bucket.emplace(pExpCtx, entry.first, entry.first, _accumulatedFields);
+            initializeAccumulators(*bucket);
+        } else if (valueCmp.evaluate(entry.first < bucket->_min)) {
+            bucket->_min = entry.first;
+        } else if (valueCmp.evaluate(entry.first > bucket->_max)) {
+            bucket->_max = entry.first;
+        }
+        accumulateDocument(entry, *bucket);
+    }
+    _bufferedInput.clear();
+    _bufferedInput.shrink_to_fit();
+    _bufferedInputBytes = 0;
+
+    // As with the exact algorithm, a bucket's max boundary is the next bucket's min, and only the
+    // last bucket has an inclusive max.
+    for (auto&& bucket : buckets) {
+        if (!bucket) {
+            continue;
+        }
+        if (!_approximateBuckets.empty()) {
+            _approximateBuckets.back()._max = bucket->_min;
+        }
+        _approximateBuckets.push_back(std::move(*bucket));
+    }
+}
+
 boost::optional<pair<Value, Document>>
 DocumentSourceBucketAuto::adjustBoundariesAndGetMinForNextBucket(Bucket* currentBucket) {
     auto getNextValIfPresent = [this]() {
@@ -351,15 +458,7 @@ boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::popu
             _granularityRounder->roundDown(currentValue.first));
     }
 
-    // Evaluate each initializer against an empty document. Normally the initializer can refer to
-    // the group key, but in $bucketAuto there is no single group key per bucket.
-    Document emptyDoc;
-    for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
-        Value initializerValue =
-            _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
-        currentBucket._accums[k]->startNewGroup(initializerValue);
-    }
-
+    initializeAccumulators(currentBucket);
 
     // Add 'approxBucketSize' number of documents to the current bucket. If this is the last bucket,
     // add all the remaining documents.
@@ -377,6 +476,17 @@ boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::popu
     return currentBucket;
 }
 
+void DocumentSourceBucketAuto::initializeAccumulators(Bucket& bucket) {
+    // Evaluate each initializer against an empty document. Normally the initializer can refer to
+    // the group key, but in $bucketAuto there is no single group key per bucket.
+    Document emptyDoc;
+    for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+        Value initializerValue =
+            _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
+        bucket._accums[k]->startNewGroup(initializerValue);
+    }
+}
+
 DocumentSourceBucketAuto::Bucket::Bucket(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     Value min,
@@ -409,6 +519,9 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
+    _quantileSketch.reset();
+    _bufferedInput.clear();
+    _approximateBuckets.clear();
 }
 
 Value DocumentSourceBucketAuto::serialize(const SerializationOptions& opts) const {
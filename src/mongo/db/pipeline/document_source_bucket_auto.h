@@ -55,6 +55,7 @@
 #include "mongo/db/pipeline/granularity_rounder.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/stage_constraints.h"
+#include "mongo/db/pipeline/value_quantile_sketch.h"
 #include "mongo/db/pipeline/variables.h"
 #include "mongo/db/query/query_shape/serialization_options.h"
 #include "mongo/db/sorter/sorter.h"
@@ -66,6 +67,12 @@ namespace mongo {
 /**
  * The $bucketAuto stage takes a user-specified number of buckets and automatically determines
  * boundaries such that the values are approximately equally distributed between those buckets.
+ *
+ * By default the boundaries are found by sorting the input on the 'groupBy' value. If the
+ * 'internalQueryBucketAutoUseQuantileSketch' knob is set, the input is instead buffered unsorted
+ * while a ValueQuantileSketch estimates the quantiles of the 'groupBy' values. The approximate
+ * quantiles become the bucket boundaries, and each buffered document is placed into its bucket by
+ * binary search over them.
  */
 class DocumentSourceBucketAuto final : public DocumentSource {
 public:
@@ -175,8 +182,22 @@ private:
      */
     GetNextResult populateSorter();
 
+    std::unique_ptr<Sorter<Value, Document>> makeSorter() const;
+
+    /**
+     * Buffers a document for the quantile sketch path. Moves the buffered documents to a sorter
+     * and gives up on the sketch if the buffer outgrows the memory limit.
+     */
+    void addToQuantileSketch(Value key, Document doc);
+
     void initializeBucketIteration();
 
+    /**
+     * Places every buffered document into the bucket given by the approximate quantiles of the
+     * 'groupBy' values, and fills '_approximateBuckets' with the non-empty buckets.
+     */
+    void initializeApproximateBuckets();
+
     /**
      * Computes the 'groupBy' expression value for 'doc'.
      */
@@ -189,11 +210,24 @@ private:
 
     boost::optional<std::pair<Value, Document>> adjustBoundariesAndGetMinForNextBucket(
         Bucket* currentBucket);
+
+    /**
+     * Starts a new group in each of the accumulators of 'bucket'.
+     */
+    void initializeAccumulators(Bucket& bucket);
+
     /**
-     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
+     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'. The
+     * 'groupBy' value of 'entry' must not be less than that of any document added before.
      */
     void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
 
+    /**
+     * Updates the accumulators in 'bucket' with the document in 'entry', without touching the
+     * bucket's boundaries.
+     */
+    void accumulateDocument(const std::pair<Value, Document>& entry, Bucket& bucket);
+
     /**
      * Makes a document using the information from bucket. This is what is returned when getNext()
      * is called.
@@ -203,6 +237,14 @@ private:
     std::unique_ptr<Sorter<Value, Document>> _sorter;
     std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
 
+    // Only set when the boundaries are taken from a quantile sketch. The input is then buffered in
+    // '_bufferedInput' until EOF, and turned into '_approximateBuckets' in a single pass.
+    std::unique_ptr<ValueQuantileSketch> _quantileSketch;
+    std::vector<std::pair<Value, Document>> _bufferedInput;
+    uint64_t _bufferedInputBytes = 0;
+    std::vector<Bucket> _approximateBuckets;
+    size_t _nextApproximateBucket = 0;
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     uint64_t _maxMemoryUsageBytes;
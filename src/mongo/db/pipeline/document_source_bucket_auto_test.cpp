@@ -30,6 +30,7 @@
 #include <bitset>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <deque>
 #include <string>
 #include <utility>
@@ -53,6 +54,7 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/value_quantile_sketch.h"
 #include "mongo/db/query/explain_options.h"
 #include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/assert.h"
@@ -1118,5 +1120,136 @@ TEST_F(BucketAutoTests, BucketAutoWithConcatArraysRespectsMemoryLimit) {
     ASSERT_THROWS_CODE(getResults(spec, docs), AssertionException, ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST_F(BucketAutoTests, QuantileSketchProducesBucketsOfSimilarSize) {
+    RAIIServerParameterControllerForTest controller("internalQueryBucketAutoUseQuantileSketch",
+                                                    true);
+    auto bucketAutoSpec = fromjson("{$bucketAuto : {groupBy : '$x', buckets: 4}}");
+
+    // Enough distinct values, in no particular order, for the sketch to have compacted them.
+    const int numDocs = 1000;
+    deque<Document> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.push_back(Document{{"x", (i * 7919) % numDocs}});
+    }
+    auto results = getResults(bucketAutoSpec, inputs);
+    ASSERT_EQUALS(results.size(), 4UL);
+
+    ASSERT_VALUE_EQ(results.front()["_id"]["min"], Value(0));
+    ASSERT_VALUE_EQ(results.back()["_id"]["max"], Value(numDocs - 1));
+    int totalCount = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const int count = results[i]["count"].getInt();
+        ASSERT_LTE(std::abs(count - numDocs / 4), 50) << results[i].toString();
+        totalCount += count;
+
+        // The buckets are contiguous, and each holds exactly the values within its boundaries.
+        const int min = results[i]["_id"]["min"].getInt();
+        const int max = results[i]["_id"]["max"].getInt();
+        if (i + 1 < results.size()) {
+            ASSERT_VALUE_EQ(results[i + 1]["_id"]["min"], Value(max));
+            ASSERT_EQ(count, max - min);
+        } else {
+            ASSERT_EQ(count, max - min + 1);
+        }
+    }
+    ASSERT_EQ(totalCount, numDocs);
+}
+
+TEST_F(BucketAutoTests, QuantileSketchKeepsEqualValuesInTheSameBucket) {
+    RAIIServerParameterControllerForTest controller("internalQueryBucketAutoUseQuantileSketch",
+                                                    true);
+    auto bucketAutoSpec = fromjson("{$bucketAuto : {groupBy : '$x', buckets: 2}}");
+
+    // Values are 1, 1, 1, 1, 1, 2, 3
+    auto results = getResults(bucketAutoSpec,
+                              {Document{{"x", 1}},
+                               Document{{"x", 3}},
+                               Document{{"x", 1}},
+                               Document{{"x", 1}},
+                               Document{{"x", 2}},
+                               Document{{"x", 1}},
+                               Document{{"x", 1}}});
+    ASSERT_EQUALS(results.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(results[0], Document(fromjson("{_id : {min : 1, max : 2}, count : 5}")));
+    ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{_id : {min : 2, max : 3}, count : 2}")));
+}
+
+TEST_F(BucketAutoTests, QuantileSketchFallsBackToSortingWhenOutOfMemory) {
+    RAIIServerParameterControllerForTest controller("internalQueryBucketAutoUseQuantileSketch",
+                                                    true);
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceBucketAutoTest");
+    expCtx->setTempDir(tempDir.path());
+    expCtx->setAllowDiskUse(true);
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
+
+    const int numBuckets = 2;
+    auto bucketAutoStage = DocumentSourceBucketAuto::create(
+        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 3}, {"largeStr", largeStr}},
+                                                   Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 2}, {"largeStr", largeStr}},
+                                                   Document{{"a", 0}, {"largeStr", largeStr}}},
+                                                  expCtx);
+    bucketAutoStage->setSource(mock.get());
+
+    auto next = bucketAutoStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}}, {"count", 2}}));
+
+    next = bucketAutoStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}}, {"count", 2}}));
+
+    ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
+}
+
+TEST(ValueQuantileSketchTest, IsExactBeforeTheFirstCompaction) {
+    ValueComparator comparator;
+    ValueQuantileSketch sketch(comparator);
+    for (int i : {4, 0, 3, 1, 2}) {
+        sketch.add(Value(i));
+    }
+    ASSERT_EQ(sketch.count(), 5);
+
+    auto quantiles = sketch.quantiles({0.0, 0.2, 0.5, 0.9, 1.0});
+    ASSERT_EQ(quantiles.size(), 5UL);
+    ASSERT_VALUE_EQ(quantiles[0], Value(0));
+    ASSERT_VALUE_EQ(quantiles[1], Value(0));
+    ASSERT_VALUE_EQ(quantiles[2], Value(2));
+    ASSERT_VALUE_EQ(quantiles[3], Value(4));
+    ASSERT_VALUE_EQ(quantiles[4], Value(4));
+}
+
+TEST(ValueQuantileSketchTest, BoundsTheRankErrorAfterCompactions) {
+    ValueComparator comparator;
+    const size_t levelCapacity = 64;
+    ValueQuantileSketch sketch(comparator, levelCapacity);
+    const int numValues = 10000;
+    for (int i = 0; i < numValues; ++i) {
+        sketch.add(Value((i * 7919) % numValues));
+    }
+    ASSERT_EQ(sketch.count(), numValues);
+    ASSERT_LT(sketch.memUsageBytes(), numValues * sizeof(Value) / 10);
+
+    // A level is first compacted once it stands for 'levelCapacity' * 2^h values, so there are at
+    // most 9 levels for 10000 values.
+    const int maxRankError = numValues * 9 / levelCapacity;
+    std::vector<double> fractions{0.1, 0.25, 0.5, 0.75, 0.9};
+    auto quantiles = sketch.quantiles(fractions);
+    ASSERT_EQ(quantiles.size(), fractions.size());
+    for (size_t i = 0; i < fractions.size(); ++i) {
+        ASSERT_LTE(std::abs(quantiles[i].getInt() - int(fractions[i] * numValues)), maxRankError)
+            << fractions[i];
+    }
+}
+
 }  // namespace
 }  // namespace mongo
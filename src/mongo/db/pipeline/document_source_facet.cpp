@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <list>
 #include <memory>
+#include <typeinfo>
 #include <vector>
 
 #include <boost/move/utility_core.hpp>
@@ -40,12 +41,16 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/document_source_facet.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -247,6 +252,72 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::optimize() {
     return this;
 }
 
+boost::intrusive_ptr<DocumentSource> DocumentSourceFacet::getCommonLeadingStage() const {
+    auto leadingStage = [](const FacetPipeline& facet) -> boost::intrusive_ptr<DocumentSource> {
+        // The first stage of every facet is the tee consumer feeding it.
+        const auto& sources = facet.pipeline->getSources();
+        return sources.size() > 1 ? *std::next(sources.begin()) : nullptr;
+    };
+    // Stages are only the same if their specs are byte for byte identical. Comparing values would
+    // for instance treat {$match: {x: NumberInt(1)}} and {$match: {x: 1.0}} as equal, although a
+    // stage may behave differently depending on the numeric type of a literal.
+    auto serializeStage = [](const DocumentSource& stage) {
+        std::vector<Value> serialized;
+        stage.serializeToArray(serialized);
+        BSONArrayBuilder bab;
+        for (auto&& value : serialized) {
+            value.addToBsonArray(&bab);
+        }
+        return bab.arr();
+    };
+
+    auto candidate = leadingStage(_facets.front());
+    // Only stages which transform or filter each document on its own can be moved out of the
+    // facets without changing what every facet sees.
+    if (!candidate ||
+        !(dynamic_cast<DocumentSourceMatch*>(candidate.get()) ||
+          dynamic_cast<DocumentSourceSingleDocumentTransformation*>(candidate.get()) ||
+          dynamic_cast<DocumentSourceUnwind*>(candidate.get()))) {
+        return nullptr;
+    }
+
+    const auto candidateSpec = serializeStage(*candidate);
+    for (auto facet = std::next(_facets.begin()); facet != _facets.end(); ++facet) {
+        auto other = leadingStage(*facet);
+        if (!other || typeid(*other) != typeid(*candidate)) {
+            return nullptr;
+        }
+        if (!serializeStage(*other).binaryEqual(candidateSpec)) {
+            return nullptr;
+        }
+    }
+    return candidate;
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceFacet::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto firstHoisted = itr;
+    while (auto stage = getCommonLeadingStage()) {
+        for (auto&& facet : _facets) {
+            auto& sources = facet.pipeline->getSources();
+            sources.erase(std::next(sources.begin()));
+            Pipeline::stitch(&sources);
+        }
+        auto inserted = container->insert(itr, std::move(stage));
+        if (firstHoisted == itr) {
+            firstHoisted = inserted;
+        }
+    }
+
+    if (firstHoisted == itr) {
+        return std::next(itr);
+    }
+    // Give the hoisted stages a chance to optimize with the stages preceding them.
+    return firstHoisted == container->begin() ? firstHoisted : std::prev(firstHoisted);
+}
+
 void DocumentSourceFacet::detachFromOperationContext() {
     for (auto&& facet : _facets) {
         facet.pipeline->detachFromOperationContext();
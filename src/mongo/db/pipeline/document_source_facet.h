@@ -187,6 +187,20 @@ private:
 
     Value serialize(const SerializationOptions& opts = SerializationOptions{}) const final;
 
+    /**
+     * Moves the longest prefix of stages shared by every facet in front of this stage, so that it
+     * is applied once to each input document instead of once per facet and can be optimized along
+     * with the stages preceding the $facet.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+    /**
+     * Returns the stage following the tee consumer of each facet if they are all equivalent and can
+     * be applied before the $facet instead, or nullptr otherwise.
+     */
+    boost::intrusive_ptr<DocumentSource> getCommonLeadingStage() const;
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -63,6 +63,7 @@
 #include "mongo/db/query/allowed_contexts.h"
 #include "mongo/db/query/bson/dotted_path_support.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/util/spill_util.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/idl/idl_parser.h"
@@ -98,6 +99,21 @@ NamespaceString parseGraphLookupFromAndResolveNamespace(const BSONElement& elem,
     return fromNss;
 }
 
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number.
+ *
+ * Each user of the Sorter must implement this function to ensure that all temporary files that the
+ * Sorter instances produce are uniquely identified using a unique file name extension with separate
+ * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
+ * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookupFileCounter;
+    return "extsort-doc-graph-lookup." +
+        std::to_string(documentSourceGraphLookupFileCounter.fetchAndAdd(1));
+}
+
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -146,7 +162,8 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     const size_t maxOutputSize =
         static_cast<size_t>(internalGraphLookupStageIntermediateDocumentMaxSizeBytes.load());
-    size_t totalSize = sizeof(Value) * _visited.size();
+    const size_t numResults = _visited.size() + _numSpilledVisited;
+    size_t totalSize = sizeof(Value) * numResults;
 
     const auto& uassertTotalSize = [&]() {
         uassert(8442700,
@@ -157,14 +174,13 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     uassertTotalSize();
     std::vector<Value> results;
-    results.reserve(_visited.size());
-    while (!_visited.empty()) {
+    results.reserve(numResults);
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        totalSize += it->second.getApproximateSize();
+        auto result = popVisited();
+        totalSize += result.getApproximateSize();
         uassertTotalSize();
-        results.emplace_back(std::move(it->second));
-        _visited.erase(it);
+        results.emplace_back(std::move(result));
     }
 
     MutableDocument output(*_input);
@@ -172,7 +188,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(!hasVisited());
 
     return output.freeze();
 }
@@ -183,7 +199,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -199,7 +215,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -213,23 +229,46 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
     }
 }
 
+Document DocumentSourceGraphLookUp::popVisited() {
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    invariant(!_spilledVisited.empty());
+    auto result = _spilledVisited.back()->next().second;
+    --_numSpilledVisited;
+    if (!_spilledVisited.back()->more()) {
+        _spilledVisited.pop_back();
+        if (_spilledVisited.empty()) {
+            // Every run has been read back, so the spill file can be removed.
+            _spillFile.reset();
+        }
+    }
+    return result;
+}
+
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    clearSpilledVisitedIds();
+    _spilledVisited.clear();
+    _numSpilledVisited = 0;
+    _spillFile.reset();
 }
 
 boost::optional<ShardId> DocumentSourceGraphLookUp::computeMergeShardId() const {
@@ -382,6 +421,9 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
                 shouldPerformAnotherQuery =
                     addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
                 addToCache(*next, queried);
+
+                // Spill as the results stream in rather than holding on to the whole level.
+                spillVisitedIfNeeded();
             }
             checkMemoryUsage();
         }
@@ -392,12 +434,15 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = sizeof(Value) * _frontier.capacity();
+
+    // The spilled '_id's are only needed to de-duplicate the search.
+    clearSpilledVisitedIds();
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() || isSpilledVisitedId(id)) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -571,7 +616,7 @@ StageConstraints DocumentSourceGraphLookUp::constraints(Pipeline::SplitState pip
     StageConstraints constraints(StreamType::kStreaming,
                                  PositionRequirement::kNone,
                                  HostTypeRequirement::kNone,
-                                 DiskUseRequirement::kNoDiskUse,
+                                 DiskUseRequirement::kWritesTmpData,
                                  FacetRequirement::kAllowed,
                                  TransactionRequirement::kAllowed,
                                  LookupRequirement::kAllowed,
@@ -620,11 +665,81 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    spillVisitedIfNeeded();
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
-            (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
-    _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
+            memoryUsageBytes() < _maxMemoryUsageBytes);
+    _cache.evictDownTo(_maxMemoryUsageBytes - memoryUsageBytes());
+}
+
+bool DocumentSourceGraphLookUp::spillVisitedIfNeeded() {
+    if (memoryUsageBytes() < _maxMemoryUsageBytes || _visited.empty() ||
+        !pExpCtx->getAllowDiskUse() || pExpCtx->getInRouter()) {
+        return false;
+    }
+    spillVisited();
+    return true;
+}
+
+void DocumentSourceGraphLookUp::spillVisited() {
+    // Ensure there is sufficient disk space for spilling
+    uassertStatusOK(ensureSufficientDiskSpaceForSpilling(
+        pExpCtx->getTempDir(), internalQuerySpillingMinAvailableDiskSpaceBytes.load()));
+
+    // Initialize '_spillFile' in a lazy manner only when it is needed.
+    if (!_spillFileStats) {
+        _spillFileStats = std::make_unique<SorterFileStats>(nullptr /* sorterTracker */);
+    }
+    if (!_spillFile) {
+        _spillFile = std::make_shared<Sorter<Value, Document>::File>(
+            pExpCtx->getTempDir() + "/" + nextFileName(), _spillFileStats.get());
+    }
+
+    // The documents are read back in no particular order, so the run is written as it is.
+    SortedFileWriter<Value, Document> writer(SortOptions().TempDir(pExpCtx->getTempDir()),
+                                             _spillFile);
+    for (auto&& [id, result] : _visited) {
+        writer.addAlreadySorted(id, result);
+
+        if (id.integral64Bit()) {
+            // Account for a full 64-bit value per '_id' until the bitmap can tell its own size.
+            if (_spilledIntegralIds.addChecked(static_cast<uint64_t>(id.coerceToLong()))) {
+                _spilledIdsUsageBytes += sizeof(uint64_t);
+            }
+        } else {
+            auto prevCapacity = _spilledIds.capacity();
+            if (_spilledIds.insert(id).second) {
+                _spilledIdsUsageBytes += id.getApproximateSize() - sizeof(Value);
+            }
+            _spilledIdsUsageBytes += sizeof(Value) * (_spilledIds.capacity() - prevCapacity);
+        }
+    }
+    _spilledVisited.emplace_back(writer.done());
+    _numSpilledVisited += _visited.size();
+
+    _spillStats.spills++;
+    _spillStats.spilledRecords += _visited.size();
+    _spillStats.numBytesSpilledEstimate += _visitedUsageBytes;
+    _spillStats.spilledDataStorageSize = _spillFileStats->bytesSpilled();
+
+    _visited.clear();
+    _visitedUsageBytes = 0;
+}
+
+bool DocumentSourceGraphLookUp::isSpilledVisitedId(const Value& id) const {
+    if (_numSpilledVisited == 0) {
+        return false;
+    }
+    if (id.integral64Bit()) {
+        return _spilledIntegralIds.contains(static_cast<uint64_t>(id.coerceToLong()));
+    }
+    return _spilledIds.find(id) != _spilledIds.end();
+}
+
+void DocumentSourceGraphLookUp::clearSpilledVisitedIds() {
+    _spilledIntegralIds = Roaring64BTree();
+    _spilledIds.clear();
+    _spilledIdsUsageBytes = 0;
 }
 
 void DocumentSourceGraphLookUp::serializeToArray(std::vector<Value>& array,
@@ -674,7 +789,18 @@ void DocumentSourceGraphLookUp::serializeToArray(std::vector<Value>& array,
                       << (indexPath ? Value(opts.serializeFieldPath(*indexPath)) : Value())));
     }
 
-    array.push_back(Value(DOC(getSourceName() << spec.freeze())));
+    MutableDocument out(DOC(getSourceName() << spec.freeze()));
+    if (opts.verbosity && *opts.verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        out["usedDisk"] = opts.serializeLiteral(_spillStats.spills > 0);
+        out["spills"] = opts.serializeLiteral(static_cast<long long>(_spillStats.spills));
+        out["spilledDataStorageSize"] =
+            opts.serializeLiteral(static_cast<long long>(_spillStats.spilledDataStorageSize));
+        out["numBytesSpilledEstimate"] =
+            opts.serializeLiteral(static_cast<long long>(_spillStats.numBytesSpilledEstimate));
+        out["spilledRecords"] =
+            opts.serializeLiteral(static_cast<long long>(_spillStats.spilledRecords));
+    }
+    array.push_back(out.freezeToValue());
 
     // If we are not explaining, the output of this method must be parseable, so serialize our
     // $unwind into a separate stage.
@@ -719,6 +845,7 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeFlatUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledIds(ValueComparator::kInstance.makeFlatUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -757,6 +884,7 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeFlatUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledIds(ValueComparator::kInstance.makeFlatUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _variables(original._variables),
       _variablesParseState(original._variablesParseState.copyWith(_variables.useIdGenerator())) {
@@ -906,3 +1034,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
 }
 
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
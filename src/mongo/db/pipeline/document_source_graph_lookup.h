@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -70,9 +71,12 @@
 #include "mongo/db/pipeline/variables.h"
 #include "mongo/db/query/query_shape/serialization_options.h"
 #include "mongo/db/server_feature_flags_gen.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/sorter/sorter_stats.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/roaring_bitmaps.h"
 
 namespace mongo {
 
@@ -80,6 +84,25 @@ class DocumentSourceGraphLookUp final : public DocumentSource {
 public:
     static constexpr StringData kStageName = "$graphLookup"_sd;
 
+    /**
+     * Describes how much of the search results had to be spilled to disk over the lifetime of
+     * this stage.
+     */
+    struct SpillStats {
+        // The number of times '_visited' was spilled to disk.
+        uint64_t spills = 0;
+
+        // The number of visited documents written to disk.
+        uint64_t spilledRecords = 0;
+
+        // The size of the spill files. Data is compressed before being written, so this differs
+        // from 'numBytesSpilledEstimate'.
+        uint64_t spilledDataStorageSize = 0;
+
+        // The estimated number of bytes evicted from memory by spilling.
+        uint64_t numBytesSpilledEstimate = 0;
+    };
+
     class LiteParsed : public LiteParsedDocumentSourceForeignCollection {
     public:
         LiteParsed(std::string parseTimeName, NamespaceString foreignNss)
@@ -184,6 +207,10 @@ public:
 
     void frontierInsertWithMemoryTracking_forTest(Value value);
 
+    const SpillStats& getSpillStats() const {
+        return _spillStats;
+    }
+
     void addVariableRefs(std::set<Variables::Id>* refs) const final {
         expression::addVariableRefs(_startWith.get(), refs);
         if (_additionalFilter) {
@@ -284,11 +311,50 @@ private:
     void addToCache(const Document& result, const ValueFlatUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, spilling
+     * '_visited' to disk first if that is allowed, and then evict from '_cache' until this source
+     * is using less than '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
+    size_t memoryUsageBytes() const {
+        return _visitedUsageBytes + _frontierUsageBytes + _spilledIdsUsageBytes;
+    }
+
+    /**
+     * Spills '_visited' to disk if this source is over its memory limit and 'allowDiskUse' permits
+     * it. Returns whether anything was spilled.
+     */
+    bool spillVisitedIfNeeded();
+
+    /**
+     * Writes the documents in '_visited' to a new run of the spill file, keeping only their '_id'
+     * values in memory so that the search can keep de-duplicating against them.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether a document with '_id' equal to 'id' was visited and spilled to disk during
+     * the current search.
+     */
+    bool isSpilledVisitedId(const Value& id) const;
+
+    void clearSpilledVisitedIds();
+
+    /**
+     * Returns whether any documents found by the last search are left to output.
+     */
+    bool hasVisited() const {
+        return !_visited.empty() || !_spilledVisited.empty();
+    }
+
+    /**
+     * Removes and returns one of the documents found by the last search. The in-memory documents
+     * are returned first, followed by any that were spilled to disk. The caller must check
+     * hasVisited() first.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -338,6 +404,23 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // The '_id' values of documents that were spilled out of '_visited' during the current search.
+    // Integral values are kept in a compressed bitmap, as numeric '_id's of different types that
+    // compare equal map to the same bit. All other values are compared using the simple collation.
+    Roaring64BTree _spilledIntegralIds;
+    ValueFlatUnorderedSet _spilledIds;
+    size_t _spilledIdsUsageBytes = 0;
+
+    // Runs of visited documents spilled to disk for the current input, and the total number of
+    // documents left to read from them. All runs are appended to '_spillFile', which is removed
+    // once every run has been read back.
+    std::unique_ptr<SorterFileStats> _spillFileStats;
+    std::shared_ptr<Sorter<Value, Document>::File> _spillFile;
+    std::vector<std::shared_ptr<Sorter<Value, Document>::Iterator>> _spilledVisited;
+    size_t _numSpilledVisited = 0;
+
+    SpillStats _spillStats;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
@@ -58,6 +58,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/unittest/assert.h"
 #include "mongo/unittest/framework.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/string_map.h"
@@ -958,5 +959,97 @@ TEST_F(DocumentSourceGraphLookUpTest, CheckFrontierMemoryUsageInternalAllocs) {
     ASSERT_EQ(graphLookupStage->getFrontierUsageBytes_forTest(), 32UL + v.getApproximateSize());
 }
 
+/**
+ * Builds a $graphLookup over a foreign collection in which every document is reachable from the
+ * start value. The mock returns every document for every query, so the second level of the search
+ * finds only documents that were already visited.
+ */
+boost::intrusive_ptr<DocumentSourceGraphLookUp> makeGraphLookupOverLargeForeignColl(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    const std::string padding(100, 'x');
+    std::deque<DocumentSource::GetNextResult> contents;
+    for (int i = 0; i < 200; ++i) {
+        contents.emplace_back(Document{{"_id", i}, {"key", 0}, {"next", 1}, {"pad", padding}});
+    }
+    for (int i = 0; i < 50; ++i) {
+        contents.emplace_back(Document{
+            {"_id", "s" + std::to_string(i)}, {"key", 0}, {"next", 1}, {"pad", padding}});
+    }
+    // These compare equal to integral '_id's above, so they must be de-duplicated against them.
+    for (int i = 0; i < 20; ++i) {
+        contents.emplace_back(Document{
+            {"_id", static_cast<double>(i)}, {"key", 0}, {"next", 1}, {"pad", padding}});
+    }
+
+    NamespaceString fromNs =
+        NamespaceString::createNamespaceString_forTest(boost::none, "test", "foreign");
+    expCtx->setResolvedNamespaces(
+        StringMap<ResolvedNamespace>{{fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->setMongoProcessInterface(std::make_shared<MockMongoInterface>(std::move(contents)));
+    return DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "next",
+        "key",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsWhenDiskUseIsAllowed) {
+    RAIIServerParameterControllerForTest maxMemory(
+        "internalDocumentSourceGraphLookupMaxMemoryBytes", 10 * 1024);
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->setTempDir(tempDir.path());
+    expCtx->setAllowDiskUse(true);
+
+    auto inputMock = DocumentSourceMock::createForTest(
+        {Document{{"_id", 0}, {"startVal", 0}}, Document{{"_id", 1}, {"startVal", 0}}}, expCtx);
+    auto graphLookupStage = makeGraphLookupOverLargeForeignColl(expCtx);
+    graphLookupStage->setSource(inputMock.get());
+
+    // Each input should see every foreign document exactly once, whether it stayed in memory or
+    // was read back from disk.
+    for (int input = 0; input < 2; ++input) {
+        auto next = graphLookupStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto results = next.getDocument().getField("results").getArray();
+        ASSERT_EQ(results.size(), 250U);
+
+        auto ids = ValueComparator::kInstance.makeFlatUnorderedValueSet();
+        for (auto&& result : results) {
+            ASSERT_TRUE(ids.insert(result.getDocument().getField("_id")).second);
+        }
+        for (int i = 0; i < 200; ++i) {
+            ASSERT_TRUE(ids.contains(Value(i)));
+        }
+    }
+    ASSERT_TRUE(graphLookupStage->getNext().isEOF());
+
+    const auto& spillStats = graphLookupStage->getSpillStats();
+    ASSERT_GT(spillStats.spills, 0U);
+    ASSERT_GT(spillStats.spilledRecords, 0U);
+    ASSERT_GT(spillStats.spilledDataStorageSize, 0U);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldFailOnMemoryLimitWhenDiskUseIsNotAllowed) {
+    RAIIServerParameterControllerForTest maxMemory(
+        "internalDocumentSourceGraphLookupMaxMemoryBytes", 10 * 1024);
+    auto expCtx = getExpCtx();
+    expCtx->setAllowDiskUse(false);
+
+    auto inputMock =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"startVal", 0}}}, expCtx);
+    auto graphLookupStage = makeGraphLookupOverLargeForeignColl(expCtx);
+    graphLookupStage->setSource(inputMock.get());
+
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+    ASSERT_EQ(graphLookupStage->getSpillStats().spills, 0U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -36,11 +36,14 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/assert.h"
 #include "mongo/unittest/framework.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/util/intrusive_counter.h"
 
 namespace mongo {
@@ -52,6 +55,18 @@ public:
 
     void runDocumentSourceGroup(int numGroups, int countPerGroup, benchmark::State& state);
 
+    // Runs the whole $group, draining every output document, under a memory limit small enough
+    // to force spilling. 'numPartitions' is the value of 'internalQueryGroupSpillPartitions'; zero
+    // selects the sorted spill path.
+    void runSpillingDocumentSourceGroup(int numGroups,
+                                        int countPerGroup,
+                                        int numPartitions,
+                                        benchmark::State& state);
+
+    // Runs the $group followed by a $sort on 'sumAccum' that has absorbed a $limit of 'limit',
+    // draining every output document of the $sort.
+    void runDocumentSourceGroupTopKSort(int numGroups, int limit, benchmark::State& state);
+
 protected:
     BSONObj _groupObj;
 };
@@ -99,6 +114,76 @@ void DocumentSourceGroupBMFixture::runDocumentSourceGroup(int numGroups,
     }
 }
 
+void DocumentSourceGroupBMFixture::runSpillingDocumentSourceGroup(int numGroups,
+                                                                  int countPerGroup,
+                                                                  int numPartitions,
+                                                                  benchmark::State& state) {
+    QueryTestServiceContext qtServiceContext;
+    auto opContext = qtServiceContext.makeOperationContext();
+    NamespaceString nss = NamespaceString::createNamespaceString_forTest("test", "bm");
+    auto expCtx = make_intrusive<ExpressionContextForTest>(opContext.get(), nss);
+    unittest::TempDir tempDir("DocumentSourceGroupBM");
+    expCtx->setTempDir(tempDir.path());
+    expCtx->setAllowDiskUse(true);
+
+    const int originalPartitions = internalQueryGroupSpillPartitions.load();
+    internalQueryGroupSpillPartitions.store(numPartitions);
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto group = DocumentSourceGroup::createFromBsonWithMaxMemoryUsage(
+            _groupObj.firstElement(), expCtx, 1024 * 1024);
+        auto mock = DocumentSourceMock::createForTest(expCtx);
+        for (int n = 0; n < countPerGroup; ++n) {
+            for (int i = 1; i <= numGroups; ++i) {
+                mock->push_back(Document{BSON("a" << i << "b" << i + 1 << "c" << n << "x" << i
+                                                  << "y" << i * 10)});
+            }
+        }
+        group->setSource(mock.get());
+        state.ResumeTiming();
+
+        int numResults = 0;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            ++numResults;
+        }
+        ASSERT_EQ(numResults, numGroups);
+    }
+
+    internalQueryGroupSpillPartitions.store(originalPartitions);
+}
+
+void DocumentSourceGroupBMFixture::runDocumentSourceGroupTopKSort(int numGroups,
+                                                                  int limit,
+                                                                  benchmark::State& state) {
+    QueryTestServiceContext qtServiceContext;
+    auto opContext = qtServiceContext.makeOperationContext();
+    NamespaceString nss = NamespaceString::createNamespaceString_forTest("test", "bm");
+    auto expCtx = make_intrusive<ExpressionContextForTest>(opContext.get(), nss);
+    auto sortPattern = SortPattern{BSON("sumAccum" << -1), expCtx};
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto group = DocumentSourceGroup::createFromBsonWithMaxMemoryUsage(
+            _groupObj.firstElement(), expCtx, std::numeric_limits<int64_t>::max());
+        auto mock = DocumentSourceMock::createForTest(expCtx);
+        for (int i = 1; i <= numGroups; ++i) {
+            mock->push_back(
+                Document{BSON("a" << i << "b" << i + 1 << "c" << 10 << "x" << i << "y" << i * 10)});
+        }
+        group->setSource(mock.get());
+        auto sort = DocumentSourceSort::create(expCtx, sortPattern, limit);
+        sort->setSource(group.get());
+        state.ResumeTiming();
+
+        int numResults = 0;
+        for (auto next = sort->getNext(); next.isAdvanced(); next = sort->getNext()) {
+            ++numResults;
+        }
+        ASSERT_EQ(numResults, limit);
+    }
+}
+
 BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupBuildPhase100KDocsPerGroup)
 (benchmark::State& state) {
     runDocumentSourceGroup(/*numGroups*/ 5, /*countPerGroup*/ 100000, state);
@@ -124,5 +209,40 @@ BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupBuildPhase1DocPerGroup)
     runDocumentSourceGroup(/*numGroups*/ 500000, /*countPerGroup*/ 1, state);
 }
 
+// With the limit equal to the number of groups, no group can be skipped before the $sort.
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupTopKSortAllOf100KGroups)
+(benchmark::State& state) {
+    runDocumentSourceGroupTopKSort(/*numGroups*/ 100000, /*limit*/ 100000, state);
+}
+
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupTopKSort10Of100KGroups)
+(benchmark::State& state) {
+    runDocumentSourceGroupTopKSort(/*numGroups*/ 100000, /*limit*/ 10, state);
+}
+
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupSpillSorted100KGroups)
+(benchmark::State& state) {
+    runSpillingDocumentSourceGroup(
+        /*numGroups*/ 100000, /*countPerGroup*/ 4, /*numPartitions*/ 0, state);
+}
+
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupSpillPartitioned100KGroups)
+(benchmark::State& state) {
+    runSpillingDocumentSourceGroup(
+        /*numGroups*/ 100000, /*countPerGroup*/ 4, /*numPartitions*/ 16, state);
+}
+
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupSpillSorted1MGroups)
+(benchmark::State& state) {
+    runSpillingDocumentSourceGroup(
+        /*numGroups*/ 1000000, /*countPerGroup*/ 1, /*numPartitions*/ 0, state);
+}
+
+BENCHMARK_F(DocumentSourceGroupBMFixture, BM_DSGroupSpillPartitioned1MGroups)
+(benchmark::State& state) {
+    runSpillingDocumentSourceGroup(
+        /*numGroups*/ 1000000, /*countPerGroup*/ 1, /*numPartitions*/ 16, state);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,11 +57,14 @@
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/aggregate_command_gen.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_streaming_group.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
@@ -69,6 +73,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/dbtests.h"  // IWYU pragma: keep
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/assert.h"
 #include "mongo/unittest/framework.h"
@@ -164,6 +169,241 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldMergeHashPartitionedSpills) {
+    RAIIServerParameterControllerForTest partitions("internalQueryGroupSpillPartitions", 4);
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    unittest::TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->setTempDir(tempDir.path());
+    expCtx->setAllowDiskUse(true);
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto makeStatement = [&](StringData fieldName, StringData op, StringData arg) {
+        auto&& [parser, _1, _2, _3] = AccumulationStatement::getParser(op);
+        auto accumulatorArg = BSON("" << arg);
+        return AccumulationStatement{
+            fieldName.toString(),
+            parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState)};
+    };
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$key", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx,
+        groupByExpression,
+        {makeStatement("count", "$sum", "$one"), makeStatement("first", "$first", "$i")},
+        maxMemoryUsageBytes);
+
+    // Every group sees its documents in several spilled runs, so the partial aggregates must be
+    // merged in the order they were written for $first to return the earliest value.
+    const int numGroups = 200;
+    const int numDocs = 2000;
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"key", i % numGroups}, {"i", i}, {"one", 1}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    stdx::unordered_set<int> keys;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        int key = doc["_id"].coerceToInt();
+        ASSERT_TRUE(keys.insert(key).second);
+        ASSERT_EQ(doc["count"].coerceToInt(), numDocs / numGroups);
+        ASSERT_EQ(doc["first"].coerceToInt(), key);
+    }
+    ASSERT_EQ(keys.size(), static_cast<size_t>(numGroups));
+
+    auto groupStats = static_cast<const GroupStats*>(group->getSpecificStats());
+    ASSERT_GT(groupStats->spills, 0u);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldFailWhenPartitionNeverFitsInMemory) {
+    // With a single partition, partitioning again never makes a partition smaller.
+    RAIIServerParameterControllerForTest partitions("internalQueryGroupSpillPartitions", 1);
+    auto expCtx = getExpCtx();
+
+    unittest::TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->setTempDir(tempDir.path());
+    expCtx->setAllowDiskUse(true);
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$key", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {}, maxMemoryUsageBytes);
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 200; ++i) {
+        inputs.emplace_back(Document{{"key", i}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(
+        [&] {
+            while (group->getNext().isAdvanced()) {
+            }
+        }(),
+        AssertionException,
+        ErrorCodes::ExceededMemoryLimit);
+}
+
+boost::intrusive_ptr<DocumentSourceGroup> makeSumGroup(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto spec = fromjson("{$group: {_id: '$key', total: {$sum: '$val'}, last: {$last: '$val'}}}");
+    return boost::dynamic_pointer_cast<DocumentSourceGroup>(
+        DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx));
+}
+
+TEST_F(DocumentSourceGroupTest, TopKSortOnlyReceivesGroupsThatCanMakeTheLimit) {
+    auto expCtx = getExpCtx();
+    auto group = makeSumGroup(expCtx);
+
+    // Group 'key' gets a total of 'key', except for groups 7 and 8 that tie at 8.
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int key = 0; key < 10; ++key) {
+        inputs.emplace_back(Document{{"key", key}, {"val", key == 7 ? 8 : key}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getGroupProcessor()->setTopK(SortPattern{BSON("total" << -1), expCtx}, 2));
+
+    // Both groups tied for second place are returned.
+    std::set<int> keys;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        keys.insert(result.getDocument()["_id"].coerceToInt());
+    }
+    ASSERT_EQ(keys, (std::set<int>{7, 8, 9}));
+}
+
+TEST_F(DocumentSourceGroupTest, TopKSortProducesSameResultsAsUnprunedGroup) {
+    auto expCtx = getExpCtx();
+    auto sortPattern = SortPattern{BSON("last" << 1 << "_id" << -1), expCtx};
+
+    auto run = [&](long long limit) {
+        auto group = makeSumGroup(expCtx);
+        std::deque<DocumentSource::GetNextResult> inputs;
+        for (int i = 0; i < 500; ++i) {
+            inputs.emplace_back(Document{{"key", i % 50}, {"val", (i * 7919) % 13}});
+        }
+        auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+        group->setSource(mock.get());
+
+        auto sort = DocumentSourceSort::create(expCtx, sortPattern, limit);
+        sort->setSource(group.get());
+        std::vector<Document> results;
+        for (auto result = sort->getNext(); result.isAdvanced(); result = sort->getNext()) {
+            results.push_back(result.releaseDocument());
+        }
+        return results;
+    };
+
+    // A limit covering every group leaves the $group output unpruned.
+    auto expected = run(50);
+    auto actual = run(5);
+    ASSERT_EQ(actual.size(), 5U);
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(actual[i], expected[i]);
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, TopKSortIsOnlySetForTopLevelGroupFields) {
+    auto expCtx = getExpCtx();
+    auto group = makeSumGroup(expCtx);
+    auto groupProcessor = group->getGroupProcessor();
+
+    ASSERT_TRUE(groupProcessor->setTopK(SortPattern{BSON("_id" << 1), expCtx}, 1));
+    ASSERT_FALSE(groupProcessor->setTopK(SortPattern{BSON("_id.a" << 1), expCtx}, 1));
+    ASSERT_FALSE(groupProcessor->setTopK(SortPattern{BSON("other" << 1), expCtx}, 1));
+    ASSERT_FALSE(groupProcessor->setTopK(
+        SortPattern{BSON("score" << BSON("$meta" << "textScore")), expCtx}, 1));
+    ASSERT_FALSE(groupProcessor->setTopK(SortPattern{BSON("total" << 1), expCtx}, 0));
+}
+
+TEST_F(DocumentSourceGroupTest, TopKSortReturnsAllGroupsWhenKeyIsAnArray) {
+    auto expCtx = getExpCtx();
+    auto group = makeSumGroup(expCtx);
+
+    // $sort compares arrays by one of their elements, so the groups can't be pruned.
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int key = 0; key < 10; ++key) {
+        inputs.emplace_back(Document{{"key", key}, {"val", std::vector<Value>{Value(key)}}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getGroupProcessor()->setTopK(SortPattern{BSON("last" << 1), expCtx}, 2));
+
+    size_t numGroups = 0;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        ++numGroups;
+    }
+    ASSERT_EQ(numGroups, 10U);
+}
+
+// A $sum over integers that counts how many times any instance is finalized.
+class AccumulatorCountingSum final : public AccumulatorState {
+public:
+    static inline int numFinalized = 0;
+
+    explicit AccumulatorCountingSum(ExpressionContext* expCtx) : AccumulatorState(expCtx) {}
+
+    void processInternal(const Value& input, bool merging) final {
+        _total += input.coerceToInt();
+    }
+
+    Value getValue(bool toBeMerged) final {
+        ++numFinalized;
+        return Value(_total);
+    }
+
+    void reset() final {
+        _total = 0;
+    }
+
+    const char* getOpName() const final {
+        return "$countingSum";
+    }
+
+private:
+    int _total = 0;
+};
+
+TEST_F(DocumentSourceGroupTest, TopKSortFinalizesEachGroupOnce) {
+    auto expCtx = getExpCtx();
+    AccumulationStatement totalStatement{
+        "total",
+        AccumulationExpression(
+            ExpressionConstant::create(expCtx.get(), Value(BSONNULL)),
+            ExpressionFieldPath::parse(expCtx.get(), "$val", expCtx->variablesParseState),
+            [expCtx] { return make_intrusive<AccumulatorCountingSum>(expCtx.get()); },
+            "$countingSum"_sd)};
+    auto group = DocumentSourceGroup::create(
+        expCtx,
+        ExpressionFieldPath::parse(expCtx.get(), "$key", expCtx->variablesParseState),
+        {totalStatement});
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int key = 0; key < 10; ++key) {
+        inputs.emplace_back(Document{{"key", key}, {"val", key}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getGroupProcessor()->setTopK(SortPattern{BSON("total" << -1), expCtx}, 2));
+
+    AccumulatorCountingSum::numFinalized = 0;
+    std::set<int> totals;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        totals.insert(result.getDocument()["total"].coerceToInt());
+    }
+    ASSERT_EQ(totals, (std::set<int>{8, 9}));
+    // Every group is finalized to compute its sort key, and the groups returned reuse that value.
+    ASSERT_EQ(AccumulatorCountingSum::numFinalized, 10);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -47,6 +47,7 @@
 #include <tuple>
 
 #include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/column/bsoncolumn.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
@@ -54,6 +55,7 @@
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/match_expression_dependencies.h"
@@ -1028,6 +1030,10 @@ DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     while (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
         auto bucketMatchedQuery = _wholeBucketFilter && _wholeBucketFilter->matchesBSON(bucket);
+        if (!bucketMatchedQuery && !bucketMayMatchEventFilter(bucket)) {
+            nextResult = pSource->getNext();
+            continue;
+        }
         _bucketUnpacker.reset(std::move(bucket), bucketMatchedQuery);
 
         uassert(5346509,
@@ -1138,6 +1144,73 @@ void DocumentSourceInternalUnpackBucket::setEventFilter(BSONObj eventFilterBson,
 
     _eventFilterDeps = {};
     match_expression::addDependencies(_eventFilter.get(), &_eventFilterDeps);
+
+    // Collect the equalities that can be checked against a single data column: top-level paths
+    // that are neither the metaField nor computed from it, compared to a value that a missing field
+    // can't match.
+    _eventFilterColumnEqualities.clear();
+    const auto& spec = _bucketUnpacker.bucketSpec();
+    auto collectEquality = [&](const MatchExpression* expr) {
+        if (expr->matchType() != MatchExpression::EQ) {
+            return;
+        }
+        auto eq = static_cast<const ComparisonMatchExpression*>(expr);
+        auto path = eq->path();
+        if (path.empty() || path.find('.') != std::string::npos ||
+            (spec.metaField() && path == *spec.metaField()) ||
+            spec.computedMetaProjFields().contains(path.toString())) {
+            return;
+        }
+        auto rhsType = eq->getData().type();
+        if (rhsType == BSONType::jstNULL || rhsType == BSONType::Undefined) {
+            return;
+        }
+        _eventFilterColumnEqualities.push_back(eq);
+    };
+    if (_eventFilter->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < _eventFilter->numChildren(); ++i) {
+            collectEquality(_eventFilter->getChild(i));
+        }
+    } else {
+        collectEquality(_eventFilter.get());
+    }
+}
+
+bool DocumentSourceInternalUnpackBucket::bucketMayMatchEventFilter(const BSONObj& bucket) const {
+    if (_eventFilterColumnEqualities.empty()) {
+        return true;
+    }
+
+    auto data = bucket.getObjectField(timeseries::kBucketDataFieldName);
+    auto columnMayMatch = [](const ComparisonMatchExpression& eq, const auto& values) {
+        for (auto&& value : values) {
+            // Arrays are matched element-wise by the path traversal of the full filter, so don't
+            // try to second-guess them here.
+            if (value.type() == BSONType::Array ||
+                (!value.eoo() && eq.matchesSingleElement(value))) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (auto eq : _eventFilterColumnEqualities) {
+        auto column = data.getField(eq->path());
+        if (column.eoo()) {
+            // No event in the bucket has the field, and the equality can't match a missing one.
+            return false;
+        }
+        if (column.type() == BSONType::BinData && column.binDataType() == BinDataType::Column) {
+            if (!columnMayMatch(*eq, BSONColumn(column))) {
+                return false;
+            }
+        } else if (column.type() == BSONType::Object) {
+            if (!columnMayMatch(*eq, column.embeddedObject())) {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 void DocumentSourceInternalUnpackBucket::internalizeProject(const BSONObj& project,
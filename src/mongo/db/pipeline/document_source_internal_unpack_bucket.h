@@ -323,6 +323,13 @@ private:
     // and SBE compatibility.
     void setEventFilter(BSONObj eventFilterBson, bool shouldOptimize);
 
+    /**
+     * Returns false if no event in 'bucket' can pass '_eventFilter' because one of the equalities
+     * in '_eventFilterColumnEqualities' has no matching value in its column. Only that one column
+     * is decompressed, so buckets that fail the check are skipped without being unpacked.
+     */
+    bool bucketMayMatchEventFilter(const BSONObj& bucket) const;
+
     /**
      * Applies optimizeAt() to all stages in the given pipeline after the stage that 'itr' points
      * to, which is the bucket unpack stage.
@@ -393,6 +400,11 @@ private:
     std::unique_ptr<MatchExpression> _eventFilter;
     BSONObj _eventFilterBson;
     DepsTracker _eventFilterDeps;
+    // Equality predicates on top-level measurement fields that every event passing '_eventFilter'
+    // must satisfy. Min/max bucket-level predicates rarely prune on such equalities when the field
+    // has many distinct values, so they are also checked against the field's column before a bucket
+    // is unpacked. Points into '_eventFilter'.
+    std::vector<const ComparisonMatchExpression*> _eventFilterColumnEqualities;
     std::unique_ptr<MatchExpression> _wholeBucketFilter;
     BSONObj _wholeBucketFilterBson;
 
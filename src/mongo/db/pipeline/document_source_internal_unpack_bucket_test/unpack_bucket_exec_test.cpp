@@ -765,6 +765,41 @@ TEST_F(InternalUnpackBucketExecTest, ThrowsOnEmptyDataValue) {
     ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 5346509);
 }
 
+TEST_F(InternalUnpackBucketExecTest, EventFilterEqualitySkipsBucketsWithoutMatchingValue) {
+    auto expCtx = getExpCtx();
+    auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageNameInternal
+                     << BSON(DocumentSourceInternalUnpackBucket::kExclude
+                             << BSONArray() << timeseries::kTimeFieldName << kUserDefinedTimeName
+                             << timeseries::kMetaFieldName << kUserDefinedMetaName
+                             << DocumentSourceInternalUnpackBucket::kBucketMaxSpanSeconds << 3600
+                             << DocumentSourceInternalUnpackBucket::kEventFilter
+                             << BSON("a" << 2)));
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(spec.firstElement(), expCtx);
+
+    // The first bucket has no event with 'a' equal to 2 and the second has no 'a' at all, so both
+    // are skipped before unpacking; they have no time column and would fail to unpack otherwise.
+    // In the last bucket, the array value can only be matched by the full filter.
+    auto source = DocumentSourceMock::createForTest(
+        {"{control: {'version': 1}, data: {a: {'0': 1, '1': 3}}}",
+         "{control: {'version': 1}, data: {b: {'0': 2}}}",
+         "{control: {'version': 1}, data: {time: {'0': Date(1), '1': Date(2), '2': Date(3)}, "
+         "a: {'0': [1, 2], '1': 2, '2': 4}}}"},
+        expCtx);
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: Date(1), a: [1, 2]}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: Date(2), a: 2}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
 TEST_F(InternalUnpackBucketExecTest, HandlesEmptyBucket) {
     auto expCtx = getExpCtx();
     auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageNameInternal
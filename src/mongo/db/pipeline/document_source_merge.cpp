@@ -37,12 +37,14 @@
 #include <tuple>
 
 #include <absl/container/node_hash_map.h>
+#include <boost/container_hash/extensions.hpp>
 #include <boost/move/utility_core.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include "mongo/bson/bsontypes.h"
+#include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/resource_pattern.h"
 #include "mongo/db/curop_failpoint_helpers.h"
@@ -434,10 +436,12 @@ std::pair<DocumentSourceMerge::BatchObject, int> DocumentSourceMerge::makeBatchO
     return {std::move(batchObject), size};
 }
 
-void DocumentSourceMerge::flush(BatchedCommandRequest bcr, BatchedObjects batch) {
+void DocumentSourceMerge::flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                BatchedCommandRequest bcr,
+                                BatchedObjects batch) {
     try {
-        DocumentSourceWriteBlock writeBlock(pExpCtx->getOperationContext());
-        _mergeProcessor->flush(getOutputNs(), std::move(bcr), std::move(batch));
+        DocumentSourceWriteBlock writeBlock(expCtx->getOperationContext());
+        _mergeProcessor->flush(expCtx, getOutputNs(), std::move(bcr), std::move(batch));
     } catch (const ExceptionFor<ErrorCodes::ImmutableField>& ex) {
         uassertStatusOKWithContext(ex.toStatus(),
                                    "$merge failed to update the matching document, did you "
@@ -466,6 +470,19 @@ void DocumentSourceMerge::flush(BatchedCommandRequest bcr, BatchedObjects batch)
     }
 }
 
+boost::optional<size_t> DocumentSourceMerge::hashForFlushOrdering(const BatchObject& obj) const {
+    // Objects whose 'on' fields may match the same target document must be written in order. The
+    // unique index backing the 'on' fields has this operation's collation, so hash the values the
+    // way that collation compares them: strings by their collation key, numbers regardless of type.
+    const BSONElementComparator comparator(BSONElementComparator::FieldNamesMode::kIgnore,
+                                           pExpCtx->getCollator());
+    size_t hash = 0;
+    for (auto&& elem : std::get<0>(obj)) {
+        boost::hash_combine(hash, comparator.hash(elem));
+    }
+    return hash;
+}
+
 BatchedCommandRequest DocumentSourceMerge::makeBatchedWriteRequest() const {
     return _mergeProcessor->getMergeStrategyDescriptor().batchedCommandGenerator(pExpCtx,
                                                                                  getOutputNs());
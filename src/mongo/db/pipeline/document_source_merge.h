@@ -236,7 +236,11 @@ private:
                         boost::optional<ChunkVersion> collectionPlacementVersion,
                         bool allowMergeOnNullishValues);
 
-    void flush(BatchedCommandRequest bcr, BatchedObjects batch) override;
+    void flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedCommandRequest bcr,
+               BatchedObjects batch) override;
+
+    boost::optional<size_t> hashForFlushOrdering(const BatchObject& obj) const override;
 
     void waitWhileFailPointEnabled() override;
 
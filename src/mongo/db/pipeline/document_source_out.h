@@ -181,19 +181,21 @@ private:
 
     void finalize() override;
 
-    void flush(BatchedCommandRequest bcr, BatchedObjects batch) override {
-        DocumentSourceWriteBlock writeBlock(pExpCtx->getOperationContext());
+    void flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedCommandRequest bcr,
+               BatchedObjects batch) override {
+        DocumentSourceWriteBlock writeBlock(expCtx->getOperationContext());
 
         auto insertCommand = bcr.extractInsertRequest();
         insertCommand->setDocuments(std::move(batch));
         auto targetEpoch = boost::none;
 
         if (_timeseries) {
-            uassertStatusOK(pExpCtx->getMongoProcessInterface()->insertTimeseries(
-                pExpCtx, _tempNs, std::move(insertCommand), _writeConcern, targetEpoch));
+            uassertStatusOK(expCtx->getMongoProcessInterface()->insertTimeseries(
+                expCtx, _tempNs, std::move(insertCommand), _writeConcern, targetEpoch));
         } else {
-            uassertStatusOK(pExpCtx->getMongoProcessInterface()->insert(
-                pExpCtx, _tempNs, std::move(insertCommand), _writeConcern, targetEpoch));
+            uassertStatusOK(expCtx->getMongoProcessInterface()->insert(
+                expCtx, _tempNs, std::move(insertCommand), _writeConcern, targetEpoch));
         }
     }
 
@@ -48,6 +48,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/feature_flag.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -627,6 +628,14 @@ intrusive_ptr<DocumentSourceSort> DocumentSourceSort::parseBoundedSort(
 }
 
 DocumentSource::GetNextResult DocumentSourceSort::populate() {
+    // A $group directly feeding a top-k sort only needs to output the groups that can make it into
+    // the top k. The $sort still runs over those groups to produce the final order.
+    if (auto limit = getLimit()) {
+        if (auto group = dynamic_cast<DocumentSourceGroup*>(pSource)) {
+            group->getGroupProcessor()->setTopK(getSortKeyPattern(), *limit);
+        }
+    }
+
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
         loadDocument(nextInput.releaseDocument());
@@ -33,15 +33,20 @@
 
 #include <fmt/format.h>
 
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/writer_util.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
+#include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/transaction_resources.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
 #include "mongo/s/write_ops/batched_command_request.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -101,6 +106,13 @@ public:
  * Two other virtual methods exist which a subclass may override: 'initialize()' and 'finalize()',
  * which are called before the first element is read from the input source, and after the last one
  * has been read, respectively.
+ *
+ * When 'internalQueryDocumentSourceWriterBackgroundFlushers' is non-zero and the output is a local
+ * collection, full batches are flushed on a background thread pool while the stage keeps reading
+ * its input. The input is split into that many lanes, each with at most one flush in flight, and
+ * 'hashForFlushOrdering()' decides which objects must share a lane to be written in order. All
+ * background flushes complete before 'doGetNext()' returns, and the first error among them is
+ * rethrown to the caller.
  */
 template <typename B>
 class DocumentSourceWriter : public DocumentSource {
@@ -153,9 +165,22 @@ protected:
     virtual void finalize() {}
 
     /**
-     * Writes the documents in 'batch' to the output namespace via 'bcr'.
+     * Writes the documents in 'batch' to the output namespace via 'bcr'. All writes must be issued
+     * through 'expCtx' rather than 'pExpCtx': for a background flush it is a copy of the stage's
+     * context bound to the OperationContext of the flushing thread.
+     */
+    virtual void flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       BatchedCommandRequest bcr,
+                       BatchedObjects batch) = 0;
+
+    /**
+     * Returns a hash of 'obj' when it must be written after every previous object with the same
+     * hash, or boost::none if it may be written in any order relative to other objects. Only used
+     * when batches are flushed in the background.
      */
-    virtual void flush(BatchedCommandRequest bcr, BatchedObjects batch) = 0;
+    virtual boost::optional<size_t> hashForFlushOrdering(const BatchObject& obj) const {
+        return boost::none;
+    }
 
     boost::optional<ShardId> computeMergeShardId() const final {
         return pExpCtx->getMongoProcessInterface()->determineSpecificMergeShard(
@@ -200,6 +225,17 @@ protected:
     const std::unique_ptr<MongoProcessInterface::WriteSizeEstimator> _writeSizeEstimator;
 
 private:
+    /**
+     * Reads the whole input, flushing each full batch synchronously. Returns the last result read
+     * from the input source.
+     */
+    GetNextResult writeInput(size_t maxBatchSizeBytes);
+
+    /**
+     * Like 'writeInput()', but hands full batches to 'numLanes' background flushers.
+     */
+    GetNextResult writeInputInBackground(size_t numLanes, size_t maxBatchSizeBytes);
+
     const NamespaceString _outputNs;
 
     bool _initialized{false};
@@ -243,8 +279,7 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
         const auto estimatedMetadataSizeBytes =
             rpc::estimateImpersonatedUserMetadataSize(pExpCtx->getOperationContext());
 
-        BatchedCommandRequest batchWrite = makeBatchedWriteRequest();
-        const auto writeHeaderSize = estimateWriteHeaderSize(batchWrite);
+        const auto writeHeaderSize = estimateWriteHeaderSize(makeBatchedWriteRequest());
         const auto initialRequestSize = estimatedMetadataSizeBytes + writeHeaderSize +
             internalQueryDocumentSourceWriterBatchExtraReservedBytes.load();
 
@@ -254,34 +289,14 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
                 initialRequestSize <= BSONObjMaxUserSize);
 
         const auto maxBatchSizeBytes = BSONObjMaxUserSize - initialRequestSize;
+        size_t numLanes = internalQueryDocumentSourceWriterBackgroundFlushers.load();
+        if (numLanes > 0 && !canFlushWriterBatchesInBackground(*pExpCtx, getOutputNs())) {
+            numLanes = 0;
+        }
 
-        BatchedObjects batch;
-        size_t bufferedBytes = 0;
         try {
-            // TODO SERVER-87422 this throws StaleConfig with
-            // featureFlagTrackUnshardedCollectionsOnShardingCatalog
-            auto nextInput = pSource->getNext();
-            for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-                waitWhileFailPointEnabled();
-
-                auto doc = nextInput.releaseDocument();
-                auto [obj, objSize] = makeBatchObject(std::move(doc));
-
-                bufferedBytes += objSize;
-                if (!batch.empty() &&
-                    (bufferedBytes > maxBatchSizeBytes ||
-                     batch.size() >= write_ops::kMaxWriteBatchSize)) {
-                    flush(std::move(batchWrite), std::move(batch));
-                    batch.clear();
-                    batchWrite = makeBatchedWriteRequest();
-                    bufferedBytes = objSize;
-                }
-                batch.push_back(std::move(obj));
-            }
-            if (!batch.empty()) {
-                flush(std::move(batchWrite), std::move(batch));
-                batch.clear();
-            }
+            auto nextInput = numLanes > 0 ? writeInputInBackground(numLanes, maxBatchSizeBytes)
+                                          : writeInput(maxBatchSizeBytes);
 
             switch (nextInput.getStatus()) {
                 case GetNextResult::ReturnStatus::kAdvanced: {
@@ -315,4 +330,145 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
     MONGO_UNREACHABLE;
 }
 
+template <typename B>
+DocumentSource::GetNextResult DocumentSourceWriter<B>::writeInput(size_t maxBatchSizeBytes) {
+    BatchedCommandRequest batchWrite = makeBatchedWriteRequest();
+    BatchedObjects batch;
+    size_t bufferedBytes = 0;
+
+    // TODO SERVER-87422 this throws StaleConfig with
+    // featureFlagTrackUnshardedCollectionsOnShardingCatalog
+    auto nextInput = pSource->getNext();
+    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+        waitWhileFailPointEnabled();
+
+        auto doc = nextInput.releaseDocument();
+        auto [obj, objSize] = makeBatchObject(std::move(doc));
+
+        bufferedBytes += objSize;
+        if (!batch.empty() &&
+            (bufferedBytes > maxBatchSizeBytes || batch.size() >= write_ops::kMaxWriteBatchSize)) {
+            flush(pExpCtx, std::move(batchWrite), std::move(batch));
+            batch.clear();
+            batchWrite = makeBatchedWriteRequest();
+            bufferedBytes = objSize;
+        }
+        batch.push_back(std::move(obj));
+    }
+    if (!batch.empty()) {
+        flush(pExpCtx, std::move(batchWrite), std::move(batch));
+        batch.clear();
+    }
+    return nextInput;
+}
+
+template <typename B>
+DocumentSource::GetNextResult DocumentSourceWriter<B>::writeInputInBackground(
+    size_t numLanes, size_t maxBatchSizeBytes) {
+    struct Lane {
+        boost::optional<BatchedCommandRequest> batchWrite;
+        BatchedObjects batch;
+        size_t bufferedBytes = 0;
+        boost::optional<Future<OpDebug::AdditiveMetrics>> inFlight;
+    };
+    std::vector<Lane> lanes(numLanes);
+    for (auto& lane : lanes) {
+        lane.batchWrite.emplace(makeBatchedWriteRequest());
+    }
+
+    auto opCtx = pExpCtx->getOperationContext();
+    WriterFlushGroup flushGroup(opCtx);
+    auto flushPool = getWriterFlushPool(opCtx->getServiceContext());
+
+    // The background flushes call into this stage, so none of them may outlive this function. When
+    // it fails, which includes its operation being interrupted while waiting for a flush, the
+    // flushes are killed first so that waiting for them does not hold up the failure.
+    ScopeGuard abandonFlushes([&] {
+        auto killCode = opCtx->getKillStatus();
+        flushGroup.killAll(killCode != ErrorCodes::OK ? killCode : ErrorCodes::Interrupted);
+        for (auto& lane : lanes) {
+            if (lane.inFlight) {
+                lane.inFlight->waitNoThrow().ignore();
+            }
+        }
+    });
+
+    auto waitForLane = [&](Lane& lane) {
+        if (!lane.inFlight) {
+            return;
+        }
+        uassertStatusOK(lane.inFlight->waitNoThrow(opCtx));
+        auto swMetrics = std::move(*lane.inFlight).getNoThrow();
+        lane.inFlight.reset();
+        uassertStatusOK(swMetrics);
+
+        // The flush ran under its own OperationContext, so report its work on this operation.
+        CurOp::get(opCtx)->debug().additiveMetrics.add(swMetrics.getValue());
+    };
+    auto flushLane = [&](Lane& lane) {
+        waitForLane(lane);
+
+        auto [promise, future] = makePromiseFuture<OpDebug::AdditiveMetrics>();
+        flushPool->schedule([this,
+                             &flushGroup,
+                             flushExpCtx = pExpCtx->copyWith(getOutputNs()),
+                             batchWrite = std::move(*lane.batchWrite),
+                             batch = std::move(lane.batch),
+                             promise = std::move(promise)](Status status) mutable {
+            promise.setWith([&] {
+                uassertStatusOK(status);
+                auto flushOpCtx = flushGroup.makeOperationContext();
+                flushExpCtx->setOperationContext(flushOpCtx.get());
+                flush(flushExpCtx, std::move(batchWrite), std::move(batch));
+                return CurOp::get(flushOpCtx.get())->debug().additiveMetrics;
+            });
+        });
+        lane.inFlight.emplace(std::move(future));
+
+        lane.batchWrite.emplace(makeBatchedWriteRequest());
+        lane.batch.clear();
+        lane.bufferedBytes = 0;
+    };
+
+    size_t unorderedLane = 0;
+    auto nextInput = pSource->getNext();
+    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+        waitWhileFailPointEnabled();
+
+        auto doc = nextInput.releaseDocument();
+        auto [obj, objSize] = makeBatchObject(std::move(doc));
+
+        // Objects that may be written in any order fill one lane at a time.
+        auto hash = hashForFlushOrdering(obj);
+        auto& lane = lanes[hash ? *hash % numLanes : unorderedLane];
+
+        lane.bufferedBytes += objSize;
+        if (!lane.batch.empty() &&
+            (lane.bufferedBytes > maxBatchSizeBytes ||
+             lane.batch.size() >= write_ops::kMaxWriteBatchSize)) {
+            flushLane(lane);
+            lane.bufferedBytes = objSize;
+            if (!hash) {
+                unorderedLane = (unorderedLane + 1) % numLanes;
+            }
+        }
+        lane.batch.push_back(std::move(obj));
+    }
+
+    for (auto& lane : lanes) {
+        if (!lane.batch.empty()) {
+            flushLane(lane);
+        }
+    }
+    for (auto& lane : lanes) {
+        waitForLane(lane);
+    }
+    abandonFlushes.dismiss();
+
+    // The writes were made by other clients, so make sure that waiting for write concern on this
+    // operation's client covers them.
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+    return nextInput;
+}
+
 }  // namespace mongo
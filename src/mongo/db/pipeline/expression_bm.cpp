@@ -34,13 +34,17 @@
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/add_fields_projection_executor.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_bm_fixture.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_test_service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -75,5 +79,45 @@ class ClassicExpressionBenchmarkFixture : public ExpressionBenchmarkFixture {
 
 BENCHMARK_EXPRESSIONS(ClassicExpressionBenchmarkFixture)
 
+/**
+ * Applies an $addFields whose computed fields repeat the same $dateToString and $getField
+ * subexpressions. The argument turns common subexpression elimination on or off.
+ */
+void BM_AddFieldsRepeatedSubexpressions(benchmark::State& state) {
+    RAIIServerParameterControllerForTest controller(
+        "internalQueryProjectionEliminateCommonSubexpressions", static_cast<bool>(state.range(0)));
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss = NamespaceString::createNamespaceString_forTest("test.bm");
+    auto exprContext = make_intrusive<ExpressionContextForTest>(opContext.get(), nss);
+
+    auto addFields = projection_executor::AddFieldsProjectionExecutor::create(
+        exprContext,
+        fromjson("{day: {$dateToString: {date: '$date', format: '%Y-%m-%d'}}, "
+                 "user: {$toString: {$getField: {field: 'user', input: '$meta'}}}, "
+                 "key: {$concat: [{$dateToString: {date: '$date', format: '%Y-%m-%d'}}, '/', "
+                 "{$toString: {$getField: {field: 'user', input: '$meta'}}}]}, "
+                 "label: {$concat: [{$toString: {$getField: {field: 'user', input: '$meta'}}}, "
+                 "'@', {$dateToString: {date: '$date', format: '%Y-%m-%d'}}]}}"));
+    addFields->optimize();
+
+    std::vector<Document> documents;
+    for (int i = 0; i < 1000; ++i) {
+        documents.push_back(
+            Document{{"date", Date_t::fromMillisSinceEpoch(i * 3600 * 1000LL)},
+                     {"meta", Document{{"user", i % 100}}}});
+    }
+
+    for (auto keepRunning : state) {
+        for (const auto& document : documents) {
+            benchmark::DoNotOptimize(addFields->applyTransformation(document));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * documents.size());
+}
+
+BENCHMARK(BM_AddFieldsRepeatedSubexpressions)->Arg(0)->Arg(1);
+
 }  // namespace
 }  // namespace mongo
@@ -203,6 +203,7 @@ public:
     void visit(const ExpressionInternalOwningShard*) override {}
     void visit(const ExpressionInternalIndexKey*) override {}
     void visit(const ExpressionInternalKeyStringValue*) override {}
+    void visit(const ExpressionInternalSharedSubexpression*) override {}
 };
 
 class DependencyVisitor : public DefaultDependencyVisitor {
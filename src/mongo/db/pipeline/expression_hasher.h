@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/expression_find_internal.h"
 #include "mongo/db/pipeline/expression_from_accumulator_quantile.h"
 #include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/expression_shared_subexpression.h"
 #include "mongo/db/pipeline/expression_visitor.h"
 #include "mongo/db/query/expression_walker.h"
 #include "mongo/util/hash_utils.h"
@@ -828,6 +829,9 @@ public:
         combine(OpType::kInternalKeyStringValue);
     }
 
+    // A shared subexpression hashes the same as the subexpression it wraps.
+    void visit(const ExpressionInternalSharedSubexpression* expr) final {}
+
     H moveHashState() {
         return std::move(_hashState);
     }
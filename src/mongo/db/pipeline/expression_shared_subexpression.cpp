@@ -0,0 +1,269 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/pipeline/expression_shared_subexpression.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/expression_find_internal.h"
+#include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/expression_hasher.h"
+#include "mongo/db/pipeline/expression_js_emit.h"
+#include "mongo/db/pipeline/expression_walker.h"
+#include "mongo/db/query/expression_walker.h"
+
+namespace mongo {
+
+ExpressionInternalSharedSubexpression::TemporaryScope::TemporaryScope(
+    const TemporaryVector& temporaries, const Document& root)
+    : _temporaries(temporaries) {
+    for (auto&& temporary : _temporaries) {
+        temporary->root = &root;
+        temporary->value = boost::none;
+    }
+}
+
+ExpressionInternalSharedSubexpression::TemporaryScope::~TemporaryScope() {
+    for (auto&& temporary : _temporaries) {
+        temporary->root = nullptr;
+        temporary->value = boost::none;
+    }
+}
+
+Value ExpressionInternalSharedSubexpression::evaluate(const Document& root,
+                                                      Variables* variables) const {
+    if (_temporary->root != &root) {
+        return _children[_kChild]->evaluate(root, variables);
+    }
+    if (!_temporary->value) {
+        _temporary->value = _children[_kChild]->evaluate(root, variables);
+    }
+    return *_temporary->value;
+}
+
+boost::intrusive_ptr<Expression> ExpressionInternalSharedSubexpression::optimize() {
+    _children[_kChild] = _children[_kChild]->optimize();
+    if (dynamic_cast<ExpressionConstant*>(_children[_kChild].get())) {
+        return _children[_kChild];
+    }
+    return this;
+}
+
+Value ExpressionInternalSharedSubexpression::serialize(const SerializationOptions& options) const {
+    return _children[_kChild]->serialize(options);
+}
+
+namespace expression {
+namespace {
+/**
+ * Gathers the variables an expression refers to and binds, and whether it can produce a different
+ * value each time it is evaluated against the same document.
+ */
+class SharingVisitor final : public SelectiveConstExpressionVisitorBase {
+public:
+    // To avoid overloaded-virtual warnings.
+    using SelectiveConstExpressionVisitorBase::visit;
+
+    void visit(const ExpressionFieldPath* expr) final {
+        referencedVariables.insert(expr->getVariableId());
+    }
+
+    void visit(const ExpressionLet* expr) final {
+        for (auto&& [id, nameAndExpression] : expr->getVariableMap()) {
+            boundVariables.insert(id);
+        }
+    }
+
+    void visit(const ExpressionMap* expr) final {
+        boundVariables.insert(expr->getVarId());
+    }
+
+    void visit(const ExpressionFilter* expr) final {
+        boundVariables.insert(expr->getVariableId());
+    }
+
+    void visit(const ExpressionReduce* expr) final {
+        boundVariables.insert(expr->getThisVar());
+        boundVariables.insert(expr->getValueVar());
+    }
+
+    void visit(const ExpressionRandom* expr) final {
+        unshareable = true;
+    }
+
+    void visit(const ExpressionFunction* expr) final {
+        unshareable = true;
+    }
+
+    void visit(const ExpressionInternalJsEmit* expr) final {
+        unshareable = true;
+    }
+
+    // These embed match expressions whose variable references are not visible to this walk.
+    void visit(const ExpressionInternalFindPositional* expr) final {
+        unshareable = true;
+    }
+
+    void visit(const ExpressionInternalFindElemMatch* expr) final {
+        unshareable = true;
+    }
+
+    absl::flat_hash_set<Variables::Id> referencedVariables;
+    absl::flat_hash_set<Variables::Id> boundVariables;
+    bool unshareable = false;
+};
+
+SharingVisitor visitForSharing(const Expression* expr) {
+    SharingVisitor visitor;
+    stage_builder::ExpressionWalker walker{&visitor, nullptr, nullptr};
+    expression_walker::walk<const Expression>(expr, &walker);
+    return visitor;
+}
+
+/**
+ * Groups the occurrences of each distinct shareable subexpression.
+ */
+class CommonSubexpressionCollector {
+public:
+    struct Occurrences {
+        // Serialized form of the subexpression. Two subexpressions with the same hash are only
+        // considered equal if their serialized forms are binary equal.
+        BSONObj serialized;
+        std::vector<boost::intrusive_ptr<Expression>*> sites;
+    };
+
+    explicit CommonSubexpressionCollector(absl::flat_hash_set<Variables::Id> boundVariables)
+        : _boundVariables(std::move(boundVariables)) {}
+
+    void collect(boost::intrusive_ptr<Expression>* site) {
+        auto expr = site->get();
+        if (!expr || dynamic_cast<ExpressionInternalSharedSubexpression*>(expr)) {
+            return;
+        }
+
+        if (isShareable(expr)) {
+            BSONObjBuilder bob;
+            expr->serialize().addToBsonObj(&bob, ""_sd);
+            auto serialized = bob.obj();
+
+            auto& candidates = _occurrencesByHash[absl::Hash<Expression>{}(*expr)];
+            auto it = std::find_if(candidates.begin(), candidates.end(), [&](const auto& other) {
+                return other.serialized.binaryEqual(serialized);
+            });
+            if (it == candidates.end()) {
+                candidates.push_back({std::move(serialized), {}});
+                it = std::prev(candidates.end());
+            }
+            it->sites.push_back(site);
+        }
+
+        for (auto&& child : expr->getChildren()) {
+            collect(&child);
+        }
+    }
+
+    const absl::flat_hash_map<size_t, std::vector<Occurrences>>& getOccurrences() const {
+        return _occurrencesByHash;
+    }
+
+private:
+    bool isShareable(const Expression* expr) const {
+        // Caching these costs about as much as evaluating them.
+        if (dynamic_cast<const ExpressionConstant*>(expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(expr)) {
+            return false;
+        }
+
+        auto visitor = visitForSharing(expr);
+        if (visitor.unshareable) {
+            return false;
+        }
+
+        // A variable bound by some enclosing expression may take a different value at each
+        // occurrence. Variables bound within 'expr' itself are fine, as are variables bound
+        // outside the projection, which do not change while a document is being projected.
+        for (auto&& id : visitor.referencedVariables) {
+            if (_boundVariables.contains(id) && !visitor.boundVariables.contains(id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every variable bound by any of the expressions being collected from.
+    absl::flat_hash_set<Variables::Id> _boundVariables;
+
+    absl::flat_hash_map<size_t, std::vector<Occurrences>> _occurrencesByHash;
+};
+}  // namespace
+
+ExpressionInternalSharedSubexpression::TemporaryVector eliminateCommonSubexpressions(
+    const std::vector<boost::intrusive_ptr<Expression>*>& expressions) {
+    absl::flat_hash_set<Variables::Id> boundVariables;
+    for (auto&& site : expressions) {
+        auto visitor = visitForSharing(site->get());
+        boundVariables.insert(visitor.boundVariables.begin(), visitor.boundVariables.end());
+    }
+
+    CommonSubexpressionCollector collector(std::move(boundVariables));
+    for (auto&& site : expressions) {
+        collector.collect(site);
+    }
+
+    // Wrapping an occurrence only replaces the pointer at its site, so the sites of occurrences
+    // nested within it stay valid and may be wrapped in turn.
+    ExpressionInternalSharedSubexpression::TemporaryVector temporaries;
+    for (auto&& [hash, candidates] : collector.getOccurrences()) {
+        for (auto&& occurrences : candidates) {
+            if (occurrences.sites.size() < 2) {
+                continue;
+            }
+            auto temporary =
+                std::make_shared<ExpressionInternalSharedSubexpression::Temporary>();
+            for (auto&& site : occurrences.sites) {
+                auto expCtx = (*site)->getExpressionContext();
+                *site = make_intrusive<ExpressionInternalSharedSubexpression>(
+                    expCtx, std::move(*site), temporary);
+            }
+            temporaries.push_back(std::move(temporary));
+        }
+    }
+    return temporaries;
+}
+}  // namespace expression
+}  // namespace mongo
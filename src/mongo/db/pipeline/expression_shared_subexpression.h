@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional/optional.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/expression_visitor.h"
+#include "mongo/db/pipeline/field_path.h"
+#include "mongo/db/pipeline/monotonic_expression.h"
+#include "mongo/db/pipeline/variables.h"
+#include "mongo/db/query/query_shape/serialization_options.h"
+
+namespace mongo {
+/**
+ * Wraps one occurrence of a subexpression which appears more than once among the computed fields
+ * of a projection. Every occurrence of the same subexpression shares a 'Temporary' holding its
+ * value for the document being projected, so that the subexpression is evaluated once per document
+ * rather than once per occurrence.
+ *
+ * This expression is never parsed. It serializes, hashes and lowers to SBE exactly as its child
+ * does. The shared value is only used while the owning projection has bound the temporary to a
+ * document with a 'TemporaryScope'; any other evaluation falls through to the child.
+ */
+class ExpressionInternalSharedSubexpression final : public Expression {
+public:
+    struct Temporary {
+        // The document the temporary is bound to, or nullptr if it is not bound.
+        const Document* root = nullptr;
+        boost::optional<Value> value;
+    };
+
+    using TemporaryVector = std::vector<std::shared_ptr<Temporary>>;
+
+    /**
+     * Binds each of 'temporaries' to 'root' for the lifetime of the scope, and discards their
+     * values when it ends.
+     */
+    class TemporaryScope {
+    public:
+        TemporaryScope(const TemporaryVector& temporaries, const Document& root);
+        ~TemporaryScope();
+
+        TemporaryScope(const TemporaryScope&) = delete;
+        TemporaryScope& operator=(const TemporaryScope&) = delete;
+
+    private:
+        const TemporaryVector& _temporaries;
+    };
+
+    ExpressionInternalSharedSubexpression(ExpressionContext* expCtx,
+                                          boost::intrusive_ptr<Expression> child,
+                                          std::shared_ptr<Temporary> temporary)
+        : Expression(expCtx, {std::move(child)}), _temporary(std::move(temporary)) {}
+
+    Value evaluate(const Document& root, Variables* variables) const final;
+
+    boost::intrusive_ptr<Expression> optimize() final;
+
+    Value serialize(const SerializationOptions& options = {}) const final;
+
+    monotonic::State getMonotonicState(const FieldPath& sortedFieldPath) const final {
+        return _children[_kChild]->getMonotonicState(sortedFieldPath);
+    }
+
+    const Expression* getChild() const {
+        return _children[_kChild].get();
+    }
+
+    void acceptVisitor(ExpressionMutableVisitor* visitor) final {
+        return visitor->visit(this);
+    }
+
+    void acceptVisitor(ExpressionConstVisitor* visitor) const final {
+        return visitor->visit(this);
+    }
+
+private:
+    static constexpr size_t _kChild = 0;
+
+    std::shared_ptr<Temporary> _temporary;
+};
+
+namespace expression {
+/**
+ * Hash-conses the subexpressions of 'expressions', which must all be evaluated against the same
+ * root document, and wraps every occurrence of a subexpression that appears more than once in an
+ * ExpressionInternalSharedSubexpression. Each element of 'expressions' may be replaced in place.
+ *
+ * A subexpression is only shared if it is deterministic and refers to no variable bound by an
+ * enclosing expression such as $let or $map, since its value could otherwise differ between
+ * occurrences. Constants, field paths and subexpressions which are already shared are left alone.
+ *
+ * Returns the temporaries backing the new shared subexpressions. The caller must bind them to each
+ * document with a TemporaryScope for the sharing to take effect.
+ */
+ExpressionInternalSharedSubexpression::TemporaryVector eliminateCommonSubexpressions(
+    const std::vector<boost::intrusive_ptr<Expression>*>& expressions);
+}  // namespace expression
+}  // namespace mongo
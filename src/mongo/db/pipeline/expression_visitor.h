@@ -173,6 +173,7 @@ class ExpressionBitAnd;
 class ExpressionBitOr;
 class ExpressionBitXor;
 class ExpressionInternalKeyStringValue;
+class ExpressionInternalSharedSubexpression;
 
 class AccumulatorAvg;
 class AccumulatorFirstN;
@@ -395,6 +396,8 @@ public:
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionInternalIndexKey>) = 0;
     virtual void visit(
         expression_walker::MaybeConstPtr<IsConst, ExpressionInternalKeyStringValue>) = 0;
+    virtual void visit(
+        expression_walker::MaybeConstPtr<IsConst, ExpressionInternalSharedSubexpression>) = 0;
 };
 
 using ExpressionMutableVisitor = ExpressionVisitor<false>;
@@ -565,5 +568,6 @@ struct SelectiveConstExpressionVisitorBase : public ExpressionConstVisitor {
     void visit(const ExpressionInternalOwningShard*) override {}
     void visit(const ExpressionInternalIndexKey*) override {}
     void visit(const ExpressionInternalKeyStringValue*) override {}
+    void visit(const ExpressionInternalSharedSubexpression*) override {}
 };
 }  // namespace mongo
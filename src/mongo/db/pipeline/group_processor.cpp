@@ -29,6 +29,9 @@
 
 #include "mongo/db/pipeline/group_processor.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
@@ -37,6 +40,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/util/spill_util.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -56,15 +60,25 @@ std::string nextFileName() {
     return "extsort-doc-group." + std::to_string(documentSourceGroupFileCounter.fetchAndAdd(1));
 }
 
+// Partitions that are still too large after this many rounds of partitioning are dominated by a
+// few large groups that further partitioning can't split, so they fail instead of being
+// partitioned again.
+constexpr int kMaxPartitionDepth = 4;
+
 }  // namespace
 
 GroupProcessor::GroupProcessor(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                int64_t maxMemoryUsageBytes)
-    : GroupProcessorBase(expCtx, maxMemoryUsageBytes) {}
+    : GroupProcessorBase(expCtx, maxMemoryUsageBytes),
+      _numSpillPartitions(internalQueryGroupSpillPartitions.load()) {}
 
 boost::optional<Document> GroupProcessor::getNext() {
     if (_spilled) {
         return getNextSpilled();
+    } else if (_partitioned) {
+        return getNextPartitioned();
+    } else if (!_topKGroups.empty()) {
+        return getNextTopK();
     } else {
         return getNextStandard();
     }
@@ -118,6 +132,18 @@ boost::optional<Document> GroupProcessor::getNextSpilled() {
     return makeDocument(currentId, _currentAccumulators, _expCtx->getNeedsMerge());
 }
 
+boost::optional<Document> GroupProcessor::getNextPartitioned() {
+    while (!_groupsIterator || *_groupsIterator == _groups.end()) {
+        if (_pendingPartitions.empty()) {
+            return boost::none;
+        }
+        auto partition = std::move(_pendingPartitions.back());
+        _pendingPartitions.pop_back();
+        loadPartition(std::move(partition));
+    }
+    return getNextStandard();
+}
+
 boost::optional<Document> GroupProcessor::getNextStandard() {
     // Not spilled, and not streaming.
     if (!_groupsIterator || _groupsIterator == _groups.end())
@@ -130,6 +156,142 @@ boost::optional<Document> GroupProcessor::getNextStandard() {
     return out;
 }
 
+boost::optional<Document> GroupProcessor::getNextTopK() {
+    if (_nextTopKGroup == _topKGroups.size())
+        return boost::none;
+
+    auto [it, groupIdx] = _topKGroups[_nextTopKGroup++];
+    const size_t numParts = _topK->sortParts.size();
+    if ((groupIdx + 1) * numParts > _topKKeys.size()) {
+        return makeDocument(it->first, it->second, _expCtx->getNeedsMerge());
+    }
+    return makeTopKDocument(it->first, it->second, _topKKeys.data() + groupIdx * numParts);
+}
+
+Document GroupProcessor::makeTopKDocument(const Value& id,
+                                          const Accumulators& accums,
+                                          const Value* sortKey) {
+    const auto& sortParts = _topK->sortParts;
+    const size_t n = _accumulatedFields.size();
+    MutableDocument out(1 + n);
+
+    out.addField("_id", expandId(id));
+
+    for (size_t i = 0; i < n; ++i) {
+        auto part = std::find_if(sortParts.begin(), sortParts.end(), [&](const auto& sortPart) {
+            return sortPart.accumulatorIdx == i;
+        });
+        if (part != sortParts.end()) {
+            // Missing values were already replaced with null in the sort key.
+            out.addField(_accumulatedFields[i].fieldName, sortKey[part - sortParts.begin()]);
+            continue;
+        }
+
+        Value val = accums[i]->getValue(/*toBeMerged=*/false);
+        out.addField(_accumulatedFields[i].fieldName,
+                     val.missing() ? Value(BSONNULL) : std::move(val));
+    }
+
+    return out.freeze();
+}
+
+bool GroupProcessor::setTopK(const SortPattern& sortPattern, long long limit) {
+    if (limit <= 0) {
+        return false;
+    }
+
+    std::vector<TopKSortPart> sortParts;
+    for (const auto& part : sortPattern) {
+        if (!part.fieldPath || part.fieldPath->getPathLength() != 1) {
+            return false;
+        }
+
+        auto fieldName = part.fieldPath->getFieldName(0);
+        if (fieldName == "_id"_sd) {
+            sortParts.push_back({boost::none, part.isAscending});
+            continue;
+        }
+
+        auto accIt = std::find_if(
+            _accumulatedFields.begin(), _accumulatedFields.end(), [&](const auto& statement) {
+                return statement.fieldName == fieldName;
+            });
+        if (accIt == _accumulatedFields.end()) {
+            return false;
+        }
+        sortParts.push_back(
+            {static_cast<size_t>(accIt - _accumulatedFields.begin()), part.isAscending});
+    }
+
+    _topK = TopK{std::move(sortParts), static_cast<size_t>(limit)};
+    return true;
+}
+
+void GroupProcessor::selectTopKGroups() {
+    const auto& sortParts = _topK->sortParts;
+    const size_t numParts = sortParts.size();
+
+    // The sort keys are kept until the groups are returned, so that no accumulator is finalized
+    // twice. Stop computing them, and return every group, if they don't fit in memory.
+    auto& keys = _topKKeys;
+    keys.reserve(_groups.size() * numParts);
+    _memoryTracker.add(keys.capacity() * sizeof(Value));
+
+    bool canPrune = true;
+    for (const auto& [id, accumulators] : _groups) {
+        if (!_memoryTracker.withinMemoryLimit()) {
+            canPrune = false;
+            break;
+        }
+        for (const auto& part : sortParts) {
+            Value val = part.accumulatorIdx
+                ? accumulators[*part.accumulatorIdx]->getValue(/*toBeMerged=*/false)
+                : expandId(id);
+            // $sort orders an array by its smallest or largest element rather than as a whole, so
+            // keys with arrays can't be compared here. Return every group instead.
+            if (val.isArray()) {
+                canPrune = false;
+            }
+            // makeDocument() outputs missing accumulated values as null.
+            keys.push_back(val.missing() ? Value(BSONNULL) : std::move(val));
+            _memoryTracker.add(keys.back().getApproximateSize() - sizeof(Value));
+        }
+    }
+
+    if (!canPrune) {
+        _topKGroups.reserve(_groups.size());
+        size_t groupIdx = 0;
+        for (auto it = _groups.begin(); it != _groups.end(); ++it, ++groupIdx) {
+            _topKGroups.emplace_back(it, groupIdx);
+        }
+        return;
+    }
+
+    const auto& valueComparator = _expCtx->getValueComparator();
+    auto keyLess = [&](size_t lhs, size_t rhs) {
+        for (size_t i = 0; i < numParts; ++i) {
+            int cmp = valueComparator.compare(keys[lhs * numParts + i], keys[rhs * numParts + i]);
+            if (cmp != 0) {
+                return sortParts[i].isAscending ? cmp < 0 : cmp > 0;
+            }
+        }
+        return false;
+    };
+
+    std::vector<size_t> order(_groups.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::nth_element(order.begin(), order.begin() + (_topK->limit - 1), order.end(), keyLess);
+    const size_t boundIdx = order[_topK->limit - 1];
+
+    _topKGroups.reserve(_topK->limit);
+    size_t groupIdx = 0;
+    for (auto it = _groups.begin(); it != _groups.end(); ++it, ++groupIdx) {
+        if (!keyLess(boundIdx, groupIdx)) {
+            _topKGroups.emplace_back(it, groupIdx);
+        }
+    }
+}
+
 namespace {
 
 using GroupsMap = GroupProcessorBase::GroupsMap;
@@ -179,6 +341,17 @@ void GroupProcessor::add(const Value& groupKey, const Document& root) {
 }
 
 void GroupProcessor::readyGroups() {
+    if (!_spilledPartitions.empty()) {
+        if (!_groups.empty()) {
+            spill();
+        }
+        _partitioned = true;
+        _pendingPartitions = std::move(_spilledPartitions);
+        _spilledPartitions.clear();
+        _groupsIterator = boost::none;
+        return;
+    }
+
     _spilled = !_sortedFiles.empty();
     if (_spilled) {
         if (!_groups.empty()) {
@@ -201,6 +374,11 @@ void GroupProcessor::readyGroups() {
     } else {
         // start the group iterator
         _groupsIterator = _groups.begin();
+
+        // Partial groups that are merged later must all be returned.
+        if (_topK && !_expCtx->getNeedsMerge() && _groups.size() > _topK->limit) {
+            selectTopKGroups();
+        }
     }
 }
 
@@ -210,6 +388,14 @@ void GroupProcessor::reset() {
 
     _sorterIterator.reset();
     _sortedFiles.clear();
+    _spilledPartitions.clear();
+    _pendingPartitions.clear();
+    _partitionFiles.clear();
+    _numPartitionedSpills = 0;
+    _partitioned = false;
+    _topKKeys.clear();
+    _topKGroups.clear();
+    _nextTopKGroup = 0;
     // Make us look done.
     _groupsIterator = _groups.end();
 }
@@ -235,7 +421,7 @@ bool GroupProcessor::shouldSpillOnEveryDuplicateId(bool isNewGroup) {
             !_expCtx->getOperationContext()->readOnly() && !isNewGroup &&  // is not a new group
             !_expCtx->getInRouter() &&        // can't spill to disk in router
             _memoryTracker.allowDiskUse() &&  // never spill when disk use is explicitly prohibited
-            _sortedFiles.size() < 20);
+            _sortedFiles.size() + _numPartitionedSpills < 20);
 }
 
 void GroupProcessor::spill() {
@@ -243,6 +429,12 @@ void GroupProcessor::spill() {
     uassertStatusOK(ensureSufficientDiskSpaceForSpilling(
         _expCtx->getTempDir(), internalQuerySpillingMinAvailableDiskSpaceBytes.load()));
 
+    if (_numSpillPartitions > 0) {
+        spillToPartitions(_spilledPartitions, 0);
+        ++_numPartitionedSpills;
+        return;
+    }
+
     std::vector<const GroupProcessorBase::GroupsMap::value_type*>
         ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups.size());
@@ -259,32 +451,139 @@ void GroupProcessor::spill() {
             _expCtx->getTempDir() + "/" + nextFileName(), _spillStats.get());
     }
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(_expCtx->getTempDir()), _file);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        writer.addAlreadySorted(ptrs[i]->first, serializeAccumulators(ptrs[i]->second));
+    }
+    _sortedFiles.emplace_back(writer.done());
+
+    recordSpill();
+}
+
+Value GroupProcessor::serializeAccumulators(const Accumulators& accumulators) const {
+    switch (_accumulatedFields.size()) {  // same as accumulators.size().
         case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+            return Value();
+        case 1:  // just one value, use optimized serialization as single Value
+            return accumulators[0]->getValue(/*toBeMerged=*/true);
+        default: {  // multiple values, serialize as array-typed Value
+            std::vector<Value> accums;
+            accums.reserve(accumulators.size());
+            for (const auto& accumulator : accumulators) {
+                accums.push_back(accumulator->getValue(/*toBeMerged=*/true));
             }
-            break;
+            return Value(std::move(accums));
+        }
+    }
+}
 
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+void GroupProcessor::spillToPartitions(std::vector<SpilledPartition>& partitions, int depth) {
+    if (partitions.empty()) {
+        partitions.resize(_numSpillPartitions, SpilledPartition{{}, depth});
+    }
+
+    // Bucket the groups by partition first so that each partition is written as one contiguous run.
+    std::vector<std::vector<const GroupsMap::value_type*>> buckets(_numSpillPartitions);
+    for (auto it = _groups.begin(), end = _groups.end(); it != end; ++it) {
+        buckets[partitionOf(it->first, depth)].push_back(&*it);
+    }
+
+    if (_partitionFiles.size() <= static_cast<size_t>(depth)) {
+        _partitionFiles.resize(depth + 1);
+    }
+    auto& file = _partitionFiles[depth];
+    if (!file) {
+        if (!_spillStats) {
+            _spillStats = std::make_unique<SorterFileStats>(nullptr /* sorterTracker */);
+        }
+        file = std::make_shared<Sorter<Value, Value>::File>(
+            _expCtx->getTempDir() + "/" + nextFileName(), _spillStats.get());
+    }
+
+    for (size_t p = 0; p < buckets.size(); ++p) {
+        if (buckets[p].empty()) {
+            continue;
+        }
+        SortedFileWriter<Value, Value> writer(SortOptions().TempDir(_expCtx->getTempDir()), file);
+        for (const auto* group : buckets[p]) {
+            writer.addAlreadySorted(group->first, serializeAccumulators(group->second));
+        }
+        partitions[p].runs.emplace_back(writer.done());
+    }
+
+    recordSpill();
+}
+
+void GroupProcessor::loadPartition(SpilledPartition partition) {
+    GroupProcessorBase::reset();
+
+    // The runs are merged in the order they were written, which keeps order-sensitive accumulators
+    // such as $first and $push consistent with the input order.
+    std::vector<SpilledPartition> subPartitions;
+    const bool canRepartition = partition.depth + 1 < kMaxPartitionDepth;
+    for (auto& run : partition.runs) {
+        while (run->more()) {
+            auto [key, states] = run->next();
+            mergeSpilledGroup(key, states);
+            if (!_memoryTracker.withinMemoryLimit()) {
+                uassert(ErrorCodes::ExceededMemoryLimit,
+                        str::stream() << "Exceeded memory limit for $group while re-aggregating a "
+                                         "spilled partition after "
+                                      << kMaxPartitionDepth << " rounds of partitioning",
+                        canRepartition);
+                spillToPartitions(subPartitions, partition.depth + 1);
             }
-            break;
+        }
+        run.reset();
+    }
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                std::vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+    if (!subPartitions.empty()) {
+        if (!_groups.empty()) {
+            spillToPartitions(subPartitions, partition.depth + 1);
+        }
+        for (auto& subPartition : subPartitions) {
+            if (!subPartition.runs.empty()) {
+                _pendingPartitions.push_back(std::move(subPartition));
             }
+        }
+    }
+    _groupsIterator = _groups.begin();
+}
+
+void GroupProcessor::mergeSpilledGroup(const Value& key, const Value& states) {
+    auto& group = findOrCreateGroup(key).first->second;
+    auto merge = [&](size_t i, const Value& state) {
+        auto& accumulator = group[i];
+        const auto prevMemUsage = accumulator->getMemUsage();
+        accumulator->process(state, true);
+        _accumulatedFieldMemoryTrackers[i]->add(accumulator->getMemUsage() - prevMemUsage);
+    };
+
+    switch (_accumulatedFields.size()) {  // mirrors serializeAccumulators()
+        case 1:
+            merge(0, states);
+            [[fallthrough]];
+        case 0:
             break;
+        default: {
+            const std::vector<Value>& accumulatorStates = states.getArray();
+            for (size_t i = 0; i < accumulatorStates.size(); i++) {
+                merge(i, accumulatorStates[i]);
+            }
+        }
     }
-    _sortedFiles.emplace_back(writer.done());
+}
+
+size_t GroupProcessor::partitionOf(const Value& key, int depth) const {
+    // Mix the depth into the hash, otherwise every group of a partition would land in the same
+    // sub-partition when it is partitioned again.
+    uint64_t h = _expCtx->getValueComparator().hash(key) + 0x9e3779b97f4a7c15ULL * (depth + 1);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h % _numSpillPartitions;
+}
 
+void GroupProcessor::recordSpill() {
     _stats.spills++;
     _stats.numBytesSpilledEstimate += _memoryTracker.currentMemoryBytes();
     _stats.spilledRecords += _groups.size();
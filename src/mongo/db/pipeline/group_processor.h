@@ -31,10 +31,12 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
 #include "mongo/db/pipeline/group_processor_base.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -61,6 +63,14 @@ public:
      */
     void add(const Value& groupKey, const Document& root);
 
+    /**
+     * Tells the processor that the consumer only keeps the first 'limit' results in the order of
+     * 'sortPattern', so that readyGroups() can skip materializing the groups that can't be among
+     * them. Only patterns made of the top-level '_id' and accumulated fields are supported. Returns
+     * false and leaves the processor unchanged otherwise. Must be called before readyGroups().
+     */
+    bool setTopK(const SortPattern& sortPattern, long long limit);
+
     /**
      * Prepares internal state to start returning fully aggregated groups back to the caller via
      * getNext() calls. Note that add() must not be called after this method is called.
@@ -88,8 +98,33 @@ public:
     }
 
 private:
+    /**
+     * The spilled runs of one hash partition, in the order they were written. 'depth' is the
+     * number of times the groups in the partition have been hash-partitioned.
+     */
+    struct SpilledPartition {
+        std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> runs;
+        int depth = 0;
+    };
+
     boost::optional<Document> getNextSpilled();
     boost::optional<Document> getNextStandard();
+    boost::optional<Document> getNextPartitioned();
+    boost::optional<Document> getNextTopK();
+
+    /**
+     * Collects into '_topKGroups' the in-memory groups whose sort key is not greater than the
+     * sort key of the '_topK->limit'-th group, in GroupsMap order. Ties with that group are kept so
+     * that the consumer picks among exactly the groups it would have seen otherwise. Collects every
+     * group if any group can't be pruned safely.
+     */
+    void selectTopKGroups();
+
+    /**
+     * Like makeDocument(), but takes the values of the accumulators in the sort pattern from
+     * 'sortKey' instead of finalizing them a second time.
+     */
+    Document makeTopKDocument(const Value& id, const Accumulators& accums, const Value* sortKey);
 
     /**
      * Cleans up any pending memory usage. Throws error, if memory usage is above
@@ -108,10 +143,43 @@ private:
     /**
      * Spills the GroupsMap to a new file and empties the map so that subsequent groups can be added
      * to it. Later when the groups need to be returned back to the caller, all groups in all the
-     * spilled files are read, merged and returned to the caller.
+     * spilled files are read, merged and returned to the caller. Spills hash partitions instead of
+     * a sorted run if '_numSpillPartitions' is set.
      */
     void spill();
 
+    /**
+     * Writes the partial aggregates of the GroupsMap as one run per non-empty hash partition,
+     * appending the runs to 'partitions', and empties the map. Unlike spill(), the groups don't
+     * need to be sorted, and each partition can later be re-aggregated on its own in a hash table.
+     */
+    void spillToPartitions(std::vector<SpilledPartition>& partitions, int depth);
+
+    /**
+     * Re-aggregates all runs of 'partition' into the GroupsMap, ready to be returned by
+     * getNextStandard(). If the partition doesn't fit within the memory limit, its groups are
+     * partitioned again with a different hash and the sub-partitions are queued instead. Throws
+     * ExceededMemoryLimit if it still doesn't fit after kMaxPartitionDepth rounds.
+     */
+    void loadPartition(SpilledPartition partition);
+
+    /**
+     * Merges the serialized partial aggregates in 'states' into the group for 'key'.
+     */
+    void mergeSpilledGroup(const Value& key, const Value& states);
+
+    size_t partitionOf(const Value& key, int depth) const;
+
+    /**
+     * Serializes the accumulators of 'group' as written by spill() and spillToPartitions().
+     */
+    Value serializeAccumulators(const Accumulators& accumulators) const;
+
+    /**
+     * Updates the spilling statistics and releases the memory of the spilled GroupsMap.
+     */
+    void recordSpill();
+
     // Only used when '_spilled' is false.
     boost::optional<GroupProcessorBase::GroupsMap::iterator> _groupsIterator;
 
@@ -125,6 +193,38 @@ private:
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
     std::pair<Value, Value> _firstPartOfNextGroup;
     GroupProcessorBase::Accumulators _currentAccumulators;
+
+    // Number of hash partitions to spill into, or 0 to spill sorted runs. Fixed at construction so
+    // that a knob change can't mix both kinds of spills in one execution.
+    const size_t _numSpillPartitions;
+    // Partitions written while consuming the input, before readyGroups().
+    std::vector<SpilledPartition> _spilledPartitions;
+    // Partitions left to return after readyGroups(), including any that were re-partitioned.
+    std::vector<SpilledPartition> _pendingPartitions;
+    // One file per partitioning depth, so that runs of one depth can be read while the next depth
+    // is being written.
+    std::vector<std::shared_ptr<Sorter<Value, Value>::File>> _partitionFiles;
+    int _numPartitionedSpills{0};
+    bool _partitioned{false};
+
+    // One component of a sort pattern set by setTopK(). 'accumulatorIdx' is boost::none for the
+    // '_id' field.
+    struct TopKSortPart {
+        boost::optional<size_t> accumulatorIdx;
+        bool isAscending;
+    };
+    struct TopK {
+        std::vector<TopKSortPart> sortParts;
+        size_t limit;
+    };
+    boost::optional<TopK> _topK;
+    // The sort keys computed by selectTopKGroups(), '_topK->sortParts.size()' values per group
+    // for a prefix of the groups in GroupsMap order.
+    std::vector<Value> _topKKeys;
+    // The groups selected by selectTopKGroups(), each with its position in GroupsMap order, and the
+    // position of the next one to return.
+    std::vector<std::pair<GroupProcessorBase::GroupsMap::iterator, size_t>> _topKGroups;
+    size_t _nextTopKGroup{0};
 };
 
 }  // namespace mongo
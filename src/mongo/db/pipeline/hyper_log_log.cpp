@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/pipeline/hyper_log_log.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "mongo/base/data_range_cursor.h"
+#include "mongo/base/data_type_endian.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+void HyperLogLog::add(uint64_t hash) {
+    if (!isSparse()) {
+        addToRegisters(hash);
+        return;
+    }
+
+    _sparse.insert(hash);
+    if (_sparse.size() > kMaxSparseSize) {
+        convertToDense();
+    }
+}
+
+void HyperLogLog::addToRegisters(uint64_t hash) {
+    // The top bits select the register and the rank is the position of the first set bit in the
+    // rest. The guard bit caps the rank at kMaxRank.
+    const size_t idx = hash >> (64 - kPrecision);
+    const uint64_t rest = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+    const auto rank = static_cast<uint8_t>(countLeadingZerosNonZero64(rest) + 1);
+    _registers[idx] = std::max(_registers[idx], rank);
+}
+
+void HyperLogLog::convertToDense() {
+    _registers.assign(kNumRegisters, 0);
+    for (auto hash : _sparse) {
+        addToRegisters(hash);
+    }
+    _sparse = {};
+}
+
+namespace {
+// The sigma and tau functions of Ertl's estimator, which account for the registers that are still
+// empty and for those that have reached the maximum rank respectively.
+double sigma(double x) {
+    if (x == 1) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y = 1;
+    double z = x;
+    double prevZ;
+    do {
+        x *= x;
+        prevZ = z;
+        z += x * y;
+        y += y;
+    } while (z != prevZ);
+    return z;
+}
+
+double tau(double x) {
+    if (x == 0 || x == 1) {
+        return 0;
+    }
+    double y = 1;
+    double z = 1 - x;
+    double prevZ;
+    do {
+        x = std::sqrt(x);
+        prevZ = z;
+        y *= 0.5;
+        z -= (1 - x) * (1 - x) * y;
+    } while (z != prevZ);
+    return z / 3;
+}
+}  // namespace
+
+long long HyperLogLog::estimate() const {
+    if (isSparse()) {
+        return static_cast<long long>(_sparse.size());
+    }
+
+    std::array<size_t, kMaxRank + 1> rankCounts{};
+    for (auto rank : _registers) {
+        ++rankCounts[rank];
+    }
+
+    const double m = kNumRegisters;
+    double z = m * tau(1 - rankCounts[kMaxRank] / m);
+    for (int rank = kMaxRank - 1; rank >= 1; --rank) {
+        z = 0.5 * (z + rankCounts[rank]);
+    }
+    z += m * sigma(rankCounts[0] / m);
+    return std::llround(m * m / (2 * std::log(2.0) * z));
+}
+
+Value HyperLogLog::serialize() const {
+    BufBuilder buf;
+    if (isSparse()) {
+        buf.appendChar(static_cast<char>(Format::kSparse));
+        buf.appendChar(static_cast<char>(kPrecision));
+        for (auto hash : _sparse) {
+            buf.appendNum(static_cast<unsigned long long>(hash));
+        }
+    } else {
+        buf.appendChar(static_cast<char>(Format::kDense));
+        buf.appendChar(static_cast<char>(kPrecision));
+        buf.appendBuf(_registers.data(), _registers.size());
+    }
+    return Value(BSONBinData(buf.buf(), buf.len(), BinDataGeneral));
+}
+
+void HyperLogLog::combine(const Value& partial) {
+    tassert(10746000,
+            "HyperLogLog sketch should have been serialized into BinData",
+            partial.getType() == BinData);
+    auto binData = partial.getBinData();
+    ConstDataRangeCursor cursor(static_cast<const char*>(binData.data), binData.length);
+
+    const auto format = static_cast<Format>(cursor.readAndAdvance<uint8_t>());
+    tassert(10746001,
+            "HyperLogLog sketch was serialized with a different precision",
+            cursor.readAndAdvance<uint8_t>() == kPrecision);
+
+    switch (format) {
+        case Format::kSparse: {
+            tassert(10746002,
+                    "Sparse HyperLogLog sketch should hold whole hashes",
+                    cursor.length() % sizeof(uint64_t) == 0);
+            while (!cursor.empty()) {
+                add(cursor.readAndAdvance<LittleEndian<uint64_t>>());
+            }
+            return;
+        }
+        case Format::kDense: {
+            tassert(10746003,
+                    "Dense HyperLogLog sketch should hold one byte per register",
+                    cursor.length() == kNumRegisters);
+            if (isSparse()) {
+                convertToDense();
+            }
+            const auto* ranks = reinterpret_cast<const uint8_t*>(cursor.data());
+            for (size_t i = 0; i < kNumRegisters; ++i) {
+                tassert(10746005, "HyperLogLog register out of range", ranks[i] <= kMaxRank);
+                _registers[i] = std::max(_registers[i], ranks[i]);
+            }
+            return;
+        }
+    }
+    tasserted(10746004, "Unknown HyperLogLog sketch format");
+}
+
+void HyperLogLog::reset() {
+    _sparse = {};
+    _registers = {};
+}
+
+}  // namespace mongo
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <absl/container/flat_hash_set.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+
+namespace mongo {
+
+/**
+ * A HyperLogLog sketch that estimates the number of distinct 64-bit hashes added to it. As in
+ * HyperLogLog++, small sketches keep the distinct hashes themselves and count them exactly. Once
+ * the hashes are folded into registers, the cardinality is computed with the estimator of Ertl,
+ * "New cardinality estimation algorithms for HyperLogLog sketches" (2017), which needs neither
+ * linear counting nor empirical bias correction for small cardinalities. With 2^14 registers the
+ * standard error of the estimate is about 0.8%.
+ *
+ * Sketches are mergeable: the sketch of the union of two inputs can be computed from the serialized
+ * sketches of each input, which lets the shards of a sharded $group send sketches rather than sets
+ * of values to the merging node.
+ */
+class HyperLogLog {
+public:
+    static constexpr int kPrecision = 14;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+    // Registers hold ranks from 0 (no hash seen) to kMaxRank.
+    static constexpr int kMaxRank = 64 - kPrecision + 1;
+
+    /**
+     * Adds a hash to the sketch. The hashes must be uniformly distributed over all 64 bits.
+     */
+    void add(uint64_t hash);
+
+    /**
+     * Returns the estimated number of distinct hashes added to this sketch and to the sketches
+     * combined into it.
+     */
+    long long estimate() const;
+
+    /**
+     * Serializes the sketch into a BinData value that can be passed to combine().
+     */
+    Value serialize() const;
+
+    /**
+     * Merges a sketch produced by serialize() into this one.
+     */
+    void combine(const Value& partial);
+
+    void reset();
+
+    size_t memUsageBytes() const {
+        return sizeof(*this) + _sparse.capacity() * (sizeof(uint64_t) + 1) +
+            _registers.capacity();
+    }
+
+private:
+    // The first byte of a serialized sketch.
+    enum class Format : uint8_t { kSparse = 0, kDense = 1 };
+
+    // The sparse representation is replaced by the registers once it would need more memory.
+    static constexpr size_t kMaxSparseSize = kNumRegisters / sizeof(uint64_t);
+
+    bool isSparse() const {
+        return _registers.empty();
+    }
+
+    void addToRegisters(uint64_t hash);
+    void convertToDense();
+
+    // The distinct hashes added so far while the sketch is sparse.
+    absl::flat_hash_set<uint64_t> _sparse;
+    // The maximum rank seen for each register once the sketch is dense, or empty if sparse.
+    std::vector<uint8_t> _registers;
+};
+
+}  // namespace mongo
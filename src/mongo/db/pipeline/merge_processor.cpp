@@ -344,10 +344,17 @@ MongoProcessInterface::BatchObject MergeProcessor::makeBatchObject(
 void MergeProcessor::flush(const NamespaceString& outputNs,
                            BatchedCommandRequest bcr,
                            MongoProcessInterface::BatchedObjects batch) const {
+    flush(_expCtx, outputNs, std::move(bcr), std::move(batch));
+}
+
+void MergeProcessor::flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                           const NamespaceString& outputNs,
+                           BatchedCommandRequest bcr,
+                           MongoProcessInterface::BatchedObjects batch) const {
     auto targetEpoch = _collectionPlacementVersion
         ? boost::optional<OID>(_collectionPlacementVersion->epoch())
         : boost::none;
-    _descriptor.strategy(_expCtx,
+    _descriptor.strategy(expCtx,
                          outputNs,
                          _writeConcern,
                          targetEpoch,
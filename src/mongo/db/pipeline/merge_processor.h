@@ -151,6 +151,14 @@ public:
                BatchedCommandRequest bcr,
                MongoProcessInterface::BatchedObjects batch) const;
 
+    /**
+     * Same as above, but issues the writes through 'expCtx' instead of the processor's own context.
+     */
+    void flush(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               const NamespaceString& outputNs,
+               BatchedCommandRequest bcr,
+               MongoProcessInterface::BatchedObjects batch) const;
+
 private:
     /**
      * Creates an UpdateModification object from the given 'doc' to be used with the batched update.
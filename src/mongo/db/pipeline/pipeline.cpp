@@ -83,8 +83,8 @@ namespace mongo {
 
 namespace {
 
-// Given a serialized document source, appends execution stats 'nReturned' and
-// 'executionTimeMillisEstimate' to it.
+// Given a serialized document source, appends execution stats 'nReturned',
+// 'executionTimeMillisEstimate' and 'documentAllocations' to it.
 Value appendCommonExecStats(Value docSource, const CommonStats& stats) {
     invariant(docSource.getType() == BSONType::Object);
     MutableDocument doc(docSource.getDocument());
@@ -102,6 +102,8 @@ Value appendCommonExecStats(Value docSource, const CommonStats& stats) {
         doc.addField("executionTimeNanos",
                      Value(durationCount<Nanoseconds>(stats.executionTime.executionTimeEstimate)));
     }
+    doc.addField("documentAllocations",
+                 Value(static_cast<long long>(stats.documentAllocations)));
     return Value(doc.freeze());
 }
 
@@ -61,6 +61,7 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/multi_iterator.h"
 #include "mongo/db/exec/multi_plan.h"
@@ -296,6 +297,26 @@ std::pair<DocumentSourceSample*, DocumentSourceInternalUnpackBucket*> extractSam
     return std::pair{sampleStage, unpackStage};
 }
 
+/**
+ * Returns the $match stage at the front of the pipeline and the $sample stage immediately after it,
+ * if there are such stages and the $match can be applied to documents fetched one at a time from a
+ * random cursor. Otherwise both elements of the pair are 'nullptr'.
+ */
+std::pair<DocumentSourceMatch*, DocumentSourceSample*> extractMatchSample(
+    const Pipeline::SourceContainer& sources) {
+    if (sources.size() < 2 || !internalQueryEnableFilteredSampleFromRandomCursor.load()) {
+        return {nullptr, nullptr};
+    }
+
+    auto matchStage = dynamic_cast<DocumentSourceMatch*>(sources.front().get());
+    auto sampleStage = dynamic_cast<DocumentSourceSample*>(std::next(sources.begin())->get());
+    // A $text predicate can only be answered by a text index.
+    if (!matchStage || !sampleStage || matchStage->isTextQuery()) {
+        return {nullptr, nullptr};
+    }
+    return {matchStage, sampleStage};
+}
+
 bool areSortFieldsModifiedByEventProjection(const SortPattern& sortPattern,
                                             const DocumentSource::GetModPathsReturn& modPaths) {
     return std::any_of(sortPattern.begin(), sortPattern.end(), [&](const auto& sortPatternPart) {
@@ -388,7 +409,8 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
     Pipeline* pipeline,
     long long sampleSize,
     long long numRecords,
-    boost::optional<timeseries::BucketUnpacker> bucketUnpacker) {
+    boost::optional<timeseries::BucketUnpacker> bucketUnpacker,
+    DocumentSourceMatch* matchStage) {
     OperationContext* opCtx = expCtx->getOperationContext();
 
     // Verify that we are already under a collection lock or in a lock-free read. We avoid taking
@@ -441,6 +463,24 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
         std::make_unique<MultiIteratorStage>(expCtx.get(), ws.get(), &coll);
     static_cast<MultiIteratorStage*>(root.get())->addIterator(std::move(rsRandCursor));
 
+    // If the $sample follows a $match, drop the random documents which don't match. The filter is
+    // a copy of the $match's, owned by a CanonicalQuery which the executor keeps alive.
+    std::unique_ptr<CanonicalQuery> cq;
+    if (matchStage) {
+        auto findCommand = std::make_unique<FindCommandRequest>(coll->ns());
+        findCommand->setFilter(matchStage->getQuery().getOwned());
+        cq = std::make_unique<CanonicalQuery>(CanonicalQueryParams{
+            .expCtx = expCtx,
+            .parsedFind = uassertStatusOK(ParsedFindCommand::withExistingFilter(
+                expCtx,
+                expCtx->getCollator() ? expCtx->getCollator()->clone() : nullptr,
+                matchStage->getMatchExpression()->clone(),
+                std::move(findCommand),
+                ProjectionPolicies::aggregateProjectionPolicies()))});
+        root = std::make_unique<FetchStage>(
+            expCtx.get(), ws.get(), std::move(root), cq->getPrimaryMatchExpression(), &coll);
+    }
+
     TrialStage* trialStage = nullptr;
 
     const auto [isSharded, optOwnershipFilter] = [&]() {
@@ -559,26 +599,42 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
             trialStage = static_cast<TrialStage*>(root.get());
         }
 
-    } else if (isSharded) {
+    } else if (isSharded || matchStage) {
         // The ratio of owned to orphaned documents must be at least equal to the ratio between the
         // requested sampleSize and the maximum permitted sampleSize for the original constraints to
         // be satisfied. For instance, if there are 200 documents and the sampleSize is 5, then at
         // least (5 / (200*0.05)) = (5/10) = 50% of those documents must be owned. If less than 5%
         // of the documents in the collection are owned, we default to the backup plan.
-        const auto minAdvancedToWorkRatio = std::max(
-            sampleSize / (numRecords * kMaxSampleRatioForRandCursor), kMaxSampleRatioForRandCursor);
-        // Since the incoming operation is sharded, use the CSS to infer the filtering metadata for
-        // the collection. We get the shard ownership filter after checking to see if the collection
-        // is sharded to avoid an invariant from being fired in this call.
-        invariant(optOwnershipFilter);
-        // The trial plan is SHARDING_FILTER-MULTI_ITERATOR.
-        auto randomCursorPlan = std::make_unique<ShardFilterStage>(
-            expCtx.get(), *optOwnershipFilter, ws.get(), std::move(root));
-        // The backup plan is SHARDING_FILTER-COLLSCAN.
-        std::unique_ptr<PlanStage> collScanPlan = std::make_unique<CollectionScan>(
-            expCtx.get(), &coll, CollectionScanParams{}, ws.get(), nullptr);
-        collScanPlan = std::make_unique<ShardFilterStage>(
-            expCtx.get(), *optOwnershipFilter, ws.get(), std::move(collScanPlan));
+        //
+        // With a preceding $match, the sample is drawn from the documents which match it, of which
+        // the trial estimates there are (advanced / works) * numRecords. That estimate must pass
+        // the same checks as 'numRecords' does above without a $match, so that a selective $match
+        // is planned as usual rather than sampled from mostly rejected random documents.
+        static const double kMinRecordsForRandCursor = 101;
+        const double minSampledRecords = matchStage
+            ? std::max(sampleSize / kMaxSampleRatioForRandCursor, kMinRecordsForRandCursor)
+            : sampleSize / kMaxSampleRatioForRandCursor;
+        const auto minAdvancedToWorkRatio =
+            std::max(minSampledRecords / numRecords, kMaxSampleRatioForRandCursor);
+        // The trial plan is [SHARDING_FILTER-][FETCH-]MULTI_ITERATOR, and the backup plan is
+        // [SHARDING_FILTER-]COLLSCAN with the $match filter, if any.
+        std::unique_ptr<PlanStage> randomCursorPlan = std::move(root);
+        std::unique_ptr<PlanStage> collScanPlan =
+            std::make_unique<CollectionScan>(expCtx.get(),
+                                             &coll,
+                                             CollectionScanParams{},
+                                             ws.get(),
+                                             cq ? cq->getPrimaryMatchExpression() : nullptr);
+        if (isSharded) {
+            // Since the incoming operation is sharded, use the CSS to infer the filtering metadata
+            // for the collection. We get the shard ownership filter after checking to see if the
+            // collection is sharded to avoid an invariant from being fired in this call.
+            invariant(optOwnershipFilter);
+            randomCursorPlan = std::make_unique<ShardFilterStage>(
+                expCtx.get(), *optOwnershipFilter, ws.get(), std::move(randomCursorPlan));
+            collScanPlan = std::make_unique<ShardFilterStage>(
+                expCtx.get(), *optOwnershipFilter, ws.get(), std::move(collScanPlan));
+        }
         // Place a TRIAL stage at the root of the plan tree, and pass it the trial and backup plans.
         root = std::make_unique<TrialStage>(expCtx.get(),
                                             ws.get(),
@@ -605,13 +661,32 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
     // either a random-sampling cursor trial plan or a COLLSCAN backup plan. We can only optimize
     // the $sample aggregation stage if the trial plan was chosen.
     const auto isStorageOptimizedSample = !trialStage || !trialStage->pickedBackupPlan();
+    if (matchStage && !isStorageOptimizedSample) {
+        // Too few of the random documents matched. Rather than scanning the whole collection, let
+        // the caller plan the $match as usual so that it may use an index.
+        return nullptr;
+    }
+
     if (!bucketUnpacker) {
         if (isStorageOptimizedSample) {
+            long long numSampledRecords = numRecords;
+            if (matchStage) {
+                // The plan applies the $match now, so remove it from the pipeline. The trial tells
+                // roughly how many documents match, which weighs this shard's sample when the
+                // samples of several shards are merged.
+                const auto* trialStats =
+                    static_cast<const TrialStats*>(trialStage->getSpecificStats());
+                numSampledRecords = std::max(
+                    1LL,
+                    std::llround(numRecords * double(trialStats->trialAdvanced) /
+                                 double(std::max<size_t>(trialStats->trialWorks, 1))));
+                pipeline->popFront();
+            }
             // Replace $sample stage with $sampleFromRandomCursor stage.
             pipeline->popFront();
             std::string idString = coll->ns().isOplog() ? "ts" : "_id";
             pipeline->addInitialSource(DocumentSourceSampleFromRandomCursor::create(
-                expCtx, sampleSize, idString, numRecords));
+                expCtx, sampleSize, idString, numSampledRecords));
         }
     } else {
         // For timeseries collections, we should remove the $_internalUnpackBucket stage which is at
@@ -630,6 +705,15 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
         }
     }
 
+    if (cq) {
+        return plan_executor_factory::make(std::move(cq),
+                                           std::move(ws),
+                                           std::move(root),
+                                           &coll,
+                                           yieldPolicy,
+                                           QueryPlannerParams::RETURN_OWNED_DATA,
+                                           coll->ns());
+    }
     return plan_executor_factory::make(expCtx,
                                        std::move(ws),
                                        std::move(root),
@@ -642,6 +726,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::createRan
 PipelineD::BuildQueryExecutorResult PipelineD::buildInnerQueryExecutorSample(
     DocumentSourceSample* sampleStage,
     DocumentSourceInternalUnpackBucket* unpackBucketStage,
+    DocumentSourceMatch* matchStage,
     const CollectionPtr& collection,
     Pipeline* pipeline) {
     tassert(5422105, "sampleStage cannot be a nullptr", sampleStage);
@@ -655,8 +740,13 @@ PipelineD::BuildQueryExecutorResult PipelineD::buildInnerQueryExecutorSample(
     if (unpackBucketStage) {
         bucketUnpacker = unpackBucketStage->bucketUnpacker().copy();
     }
-    auto exec = uassertStatusOK(createRandomCursorExecutor(
-        collection, expCtx, pipeline, sampleSize, numRecords, std::move(bucketUnpacker)));
+    auto exec = uassertStatusOK(createRandomCursorExecutor(collection,
+                                                           expCtx,
+                                                           pipeline,
+                                                           sampleSize,
+                                                           numRecords,
+                                                           std::move(bucketUnpacker),
+                                                           matchStage));
 
     AttachExecutorCallback attachExecutorCallback;
     if (exec) {
@@ -710,8 +800,19 @@ PipelineD::BuildQueryExecutorResult PipelineD::buildInnerQueryExecutor(
 
         // Optimize an initial $sample stage if possible.
         if (collection && sampleStage) {
-            auto queryExecutors =
-                buildInnerQueryExecutorSample(sampleStage, unpackBucketStage, collection, pipeline);
+            auto queryExecutors = buildInnerQueryExecutorSample(
+                sampleStage, unpackBucketStage, nullptr, collection, pipeline);
+            if (queryExecutors.mainExecutor) {
+                return queryExecutors;
+            }
+        }
+
+        // Likewise for a $sample immediately after an initial $match, if enough of the randomly
+        // chosen documents match.
+        auto&& [matchStage, sampleAfterMatchStage] = extractMatchSample(sources);
+        if (collection && matchStage) {
+            auto queryExecutors = buildInnerQueryExecutorSample(
+                sampleAfterMatchStage, nullptr, matchStage, collection, pipeline);
             if (queryExecutors.mainExecutor) {
                 return queryExecutors;
             }
@@ -225,11 +225,12 @@ private:
      * DocumentSourceInternalUnpackBucket stage that has been rewritten to sample buckets using a
      * storage engine supplied random cursor if the heuristics used for the optimization allows. If
      * the optimized $sample plan cannot or should not be produced, returns a null PlanExecutor
-     * pointer.
+     * pointer. A non-null 'matchStage' is the leading $match which 'sampleStage' follows.
      */
     static BuildQueryExecutorResult buildInnerQueryExecutorSample(
         DocumentSourceSample* sampleStage,
         DocumentSourceInternalUnpackBucket* unpackBucketStage,
+        DocumentSourceMatch* matchStage,
         const CollectionPtr& collection,
         Pipeline* pipeline);
 
@@ -244,6 +245,11 @@ private:
      * stage will also be erased and pushed down. In the sharded case, we still need a separate
      * $sample stage to preserve sorting metadata for the AsyncResultsMerger to merge samples
      * returned by multiple shards.
+     *
+     * If 'matchStage' is given, it is the $match which the $sample follows. The random cursor plan
+     * then filters the documents it returns, and is only used if a trial shows that enough of them
+     * match. In that case both the $match and the $sample are replaced by $sampleFromRandomCursor;
+     * otherwise the pipeline is left untouched and nullptr is returned.
      */
     static StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
     createRandomCursorExecutor(const CollectionPtr& coll,
@@ -251,7 +257,8 @@ private:
                                Pipeline* pipeline,
                                long long sampleSize,
                                long long numRecords,
-                               boost::optional<timeseries::BucketUnpacker> bucketUnpacker);
+                               boost::optional<timeseries::BucketUnpacker> bucketUnpacker,
+                               DocumentSourceMatch* matchStage);
 
     typedef bool IndexSortOrderAgree;
     typedef bool IndexOrderedByMinTime;
@@ -4531,6 +4531,79 @@ TEST(PipelineOptimizationTest, CoalesceAdjacentExclusionProjectionsNestedSecond)
     assertPipelineOptimizesTo(inputPipe, outputPipe);
 }
 
+TEST(PipelineOptimizationTest, FacetCommonPrefixIsMovedBeforeFacet) {
+    const std::string inputPipe =
+        "[{$facet: {"
+        "  a: [{$match: {x: 1}}, {$unwind: '$y'}, {$skip: 1}],"
+        "  b: [{$match: {x: 1}}, {$unwind: '$y'}, {$limit: 1}]"
+        "}}]";
+    const std::string outputPipe =
+        "[{$match: {x: {$eq: 1}}}"
+        ",{$unwind: {path: '$y'}}"
+        ",{$facet: {a: [{$skip: 1}], b: [{$limit: 1}]}}"
+        "]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe);
+}
+
+TEST(PipelineOptimizationTest, FacetWhollySharedPipelineIsMovedBeforeFacet) {
+    const std::string inputPipe =
+        "[{$facet: {"
+        "  a: [{$match: {x: 1}}],"
+        "  b: [{$match: {x: 1}}, {$skip: 1}]"
+        "}}]";
+    const std::string outputPipe =
+        "[{$match: {x: {$eq: 1}}}"
+        ",{$facet: {a: [], b: [{$skip: 1}]}}"
+        "]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe);
+}
+
+TEST(PipelineOptimizationTest, FacetDivergentLeadingStagesAreNotMoved) {
+    const std::string inputPipe =
+        "[{$facet: {"
+        "  a: [{$match: {x: 1}}],"
+        "  b: [{$match: {x: 2}}]"
+        "}}]";
+    const std::string outputPipe =
+        "[{$facet: {a: [{$match: {x: {$eq: 1}}}], b: [{$match: {x: {$eq: 2}}}]}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe);
+}
+
+TEST(PipelineOptimizationTest, FacetLeadingStagesDifferingInNumericTypeAreNotMoved) {
+    const std::string inputPipe =
+        "[{$facet: {"
+        "  a: [{$addFields: {y: {$const: NumberInt(1)}}}],"
+        "  b: [{$addFields: {y: {$const: 1.0}}}],"
+        "  c: [{$addFields: {y: {$const: NumberDecimal(\"1\")}}}]"
+        "}}]";
+    const std::string outputPipe =
+        "[{$facet: {"
+        "  a: [{$addFields: {y: {$const: 1}}}],"
+        "  b: [{$addFields: {y: {$const: 1.0}}}],"
+        "  c: [{$addFields: {y: {$const: NumberDecimal(\"1\")}}}]"
+        "}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe);
+}
+
+TEST(PipelineOptimizationTest, FacetSharedBlockingStageIsNotMoved) {
+    const std::string inputPipe =
+        "[{$facet: {"
+        "  a: [{$sort: {x: 1}}, {$skip: 1}],"
+        "  b: [{$sort: {x: 1}}, {$limit: 1}]"
+        "}}]";
+    const std::string outputPipe =
+        "[{$facet: {"
+        "  a: [{$sort: {sortKey: {x: 1}}}, {$skip: 1}],"
+        "  b: [{$sort: {sortKey: {x: 1}, limit: 1}}]"
+        "}}]";
+    const std::string serializedPipe =
+        "[{$facet: {"
+        "  a: [{$sort: {x: 1}}, {$skip: 1}],"
+        "  b: [{$sort: {x: 1}}, {$limit: 1}]"
+        "}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
 }  // namespace Local
 
 namespace Sharded {
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/pipeline/value_quantile_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+ValueQuantileSketch::ValueQuantileSketch(const ValueComparator& comparator, size_t levelCapacity)
+    : _comparator(comparator), _levelCapacity(levelCapacity), _levels(1), _keepOdd(1, false) {
+    tassert(10746006,
+            "The level capacity of a quantile sketch must be an even number greater than zero",
+            levelCapacity > 0 && levelCapacity % 2 == 0);
+}
+
+void ValueQuantileSketch::add(Value value) {
+    _memUsageBytes += value.getApproximateSize();
+    _levels.front().push_back(std::move(value));
+    ++_count;
+
+    // Compacting a level adds half of its values to the level above, which may in turn fill up.
+    for (size_t level = 0; level < _levels.size() && _levels[level].size() >= _levelCapacity;
+         ++level) {
+        compact(level);
+    }
+}
+
+void ValueQuantileSketch::compact(size_t level) {
+    if (level + 1 == _levels.size()) {
+        _levels.emplace_back();
+        _keepOdd.push_back(false);
+    }
+
+    auto& values = _levels[level];
+    auto& promoted = _levels[level + 1];
+    std::sort(values.begin(), values.end(), _comparator.getLessThan());
+
+    // The level always holds an even number of values here, so both halves have the same weight.
+    for (size_t i = 0; i < values.size(); ++i) {
+        if ((i % 2 == 1) == _keepOdd[level]) {
+            promoted.push_back(std::move(values[i]));
+        } else {
+            _memUsageBytes -= values[i].getApproximateSize();
+        }
+    }
+    values.clear();
+    _keepOdd[level] = !_keepOdd[level];
+}
+
+std::vector<Value> ValueQuantileSketch::quantiles(const std::vector<double>& fractions) const {
+    std::vector<std::pair<const Value*, long long>> weighted;
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        for (auto&& value : _levels[level]) {
+            weighted.emplace_back(&value, 1LL << level);
+        }
+    }
+    if (weighted.empty()) {
+        return {};
+    }
+
+    const auto lessThan = _comparator.getLessThan();
+    std::sort(weighted.begin(), weighted.end(), [&](const auto& lhs, const auto& rhs) {
+        return lessThan(*lhs.first, *rhs.first);
+    });
+
+    // The total weight of the retained values is always the number of values added.
+    std::vector<long long> cumulativeWeights;
+    cumulativeWeights.reserve(weighted.size());
+    long long totalWeight = 0;
+    for (auto&& [value, weight] : weighted) {
+        cumulativeWeights.push_back(totalWeight += weight);
+    }
+
+    std::vector<Value> result;
+    result.reserve(fractions.size());
+    for (double fraction : fractions) {
+        tassert(10746007,
+                "Quantile fractions must lie between 0 and 1",
+                fraction >= 0.0 && fraction <= 1.0);
+        // The quantile is the first value that is preceded by, or is one of, 'rank' inputs.
+        const auto rank = static_cast<long long>(std::ceil(fraction * totalWeight));
+        const auto it = std::lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), rank);
+        const size_t index = std::min<size_t>(it - cumulativeWeights.begin(), weighted.size() - 1);
+        result.push_back(*weighted[index].first);
+    }
+    return result;
+}
+
+}  // namespace mongo
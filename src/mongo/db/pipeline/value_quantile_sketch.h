@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+
+namespace mongo {
+
+/**
+ * A deterministic streaming quantile sketch over Values, in the style of the Munro-Paterson and
+ * KLL sketches. Values are appended to level 0. Whenever a level holds 'levelCapacity' values it is
+ * sorted and every other value is promoted to the level above, where each value stands for twice as
+ * many inputs as it did below. Successive compactions of a level alternate between keeping the
+ * values at even and at odd positions, so that their rank errors tend to cancel out.
+ *
+ * The sketch retains O(levelCapacity * log(n / levelCapacity)) of the n values added to it. The
+ * rank of a value returned by quantiles() is off by at most n * L / levelCapacity, where L is the
+ * number of levels, and by much less for most inputs.
+ */
+class ValueQuantileSketch {
+public:
+    static constexpr size_t kDefaultLevelCapacity = 256;
+
+    explicit ValueQuantileSketch(const ValueComparator& comparator,
+                                 size_t levelCapacity = kDefaultLevelCapacity);
+
+    void add(Value value);
+
+    /**
+     * Returns, for each fraction 'f' in 'fractions', the smallest retained value which is
+     * estimated to be greater than or equal to at least f * count() of the values added so far.
+     * The fractions must lie in [0, 1]. Returns an empty vector if no value has been added.
+     */
+    std::vector<Value> quantiles(const std::vector<double>& fractions) const;
+
+    /**
+     * The number of values added to the sketch.
+     */
+    long long count() const {
+        return _count;
+    }
+
+    size_t memUsageBytes() const {
+        return sizeof(*this) + _memUsageBytes;
+    }
+
+private:
+    void compact(size_t level);
+
+    ValueComparator _comparator;
+    size_t _levelCapacity;
+
+    // The values retained at each level. A value at level 'h' stands for 2^h of the input values.
+    std::vector<std::vector<Value>> _levels;
+    // Whether the next compaction of each level keeps the values at odd positions.
+    std::vector<bool> _keepOdd;
+
+    long long _count = 0;
+    // The approximate size of the retained values.
+    size_t _memUsageBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mongo/platform/random.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A multiset of doubles which can also return the element at any rank in sorted order. It is
+ * implemented as a treap whose nodes hold one distinct value, the number of copies of that value
+ * and the total number of copies in their subtree, so insert(), erase() and select() all take
+ * O(log n) expected time. This lets sliding windows add and remove values without shifting the
+ * rest of the window, as a sorted array has to.
+ *
+ * NaN compares less than every other value and equal to itself, so it can be added and removed
+ * like any other number.
+ */
+class OrderStatisticTree {
+public:
+    void insert(double value) {
+        if (auto node = find(value); node != kNull) {
+            adjustPath(value, 1);
+            return;
+        }
+        auto [lower, upper] = split(_root, value, false /* inclusive */);
+        _root = merge(merge(lower, newNode(value)), upper);
+    }
+
+    /**
+     * Removes one copy of 'value'. Returns false if 'value' is not in the tree.
+     */
+    bool erase(double value) {
+        auto node = find(value);
+        if (node == kNull) {
+            return false;
+        }
+        if (_nodes[node].count > 1) {
+            adjustPath(value, -1);
+            return true;
+        }
+        auto [lower, rest] = split(_root, value, false /* inclusive */);
+        auto [equal, upper] = split(rest, value, true /* inclusive */);
+        freeNode(equal);
+        _root = merge(lower, upper);
+        return true;
+    }
+
+    /**
+     * Returns the value with the 0-based position 'rank' in sorted order.
+     */
+    double select(size_t rank) const {
+        tassert(10745900, "Rank is out of bounds", rank < size());
+        auto node = _root;
+        while (true) {
+            const auto& n = _nodes[node];
+            auto leftSize = subtreeSize(n.left);
+            if (rank < leftSize) {
+                node = n.left;
+            } else if (rank < leftSize + n.count) {
+                return n.value;
+            } else {
+                rank -= leftSize + n.count;
+                node = n.right;
+            }
+        }
+    }
+
+    size_t size() const {
+        return subtreeSize(_root);
+    }
+
+    bool empty() const {
+        return _root == kNull;
+    }
+
+    void clear() {
+        _nodes.clear();
+        _nodes.shrink_to_fit();
+        _freeList.clear();
+        _freeList.shrink_to_fit();
+        _root = kNull;
+    }
+
+    /**
+     * Approximate number of bytes used by the distinct values in this tree. Slots of removed values
+     * are kept for reuse but not counted, so that the usage goes down as values are removed.
+     */
+    size_t memUsageBytes() const {
+        return (_nodes.size() - _freeList.size()) * sizeof(Node);
+    }
+
+private:
+    static constexpr int32_t kNull = -1;
+
+    struct Node {
+        double value;
+        uint32_t priority;
+        uint32_t count;
+        size_t size;
+        int32_t left;
+        int32_t right;
+    };
+
+    static bool less(double lhs, double rhs) {
+        return lhs < rhs || (std::isnan(lhs) && !std::isnan(rhs));
+    }
+
+    size_t subtreeSize(int32_t node) const {
+        return node == kNull ? 0 : _nodes[node].size;
+    }
+
+    void update(int32_t node) {
+        auto& n = _nodes[node];
+        n.size = n.count + subtreeSize(n.left) + subtreeSize(n.right);
+    }
+
+    int32_t find(double value) const {
+        auto node = _root;
+        while (node != kNull) {
+            const auto& n = _nodes[node];
+            if (less(value, n.value)) {
+                node = n.left;
+            } else if (less(n.value, value)) {
+                node = n.right;
+            } else {
+                break;
+            }
+        }
+        return node;
+    }
+
+    // Adds 'delta' to the count of the node holding 'value', which must exist, and to the sizes of
+    // every subtree on the path to it.
+    void adjustPath(double value, int32_t delta) {
+        auto node = _root;
+        while (true) {
+            auto& n = _nodes[node];
+            n.size += delta;
+            if (less(value, n.value)) {
+                node = n.left;
+            } else if (less(n.value, value)) {
+                node = n.right;
+            } else {
+                n.count += delta;
+                return;
+            }
+        }
+    }
+
+    // Splits the treap rooted at 'node' into the values less than 'value' (or less than or equal
+    // to it when 'inclusive' is true) and the remaining ones.
+    std::pair<int32_t, int32_t> split(int32_t node, double value, bool inclusive) {
+        if (node == kNull) {
+            return {kNull, kNull};
+        }
+        auto& n = _nodes[node];
+        bool goesLeft = inclusive ? !less(value, n.value) : less(n.value, value);
+        if (goesLeft) {
+            auto [lower, upper] = split(n.right, value, inclusive);
+            _nodes[node].right = lower;
+            update(node);
+            return {node, upper};
+        } else {
+            auto [lower, upper] = split(n.left, value, inclusive);
+            _nodes[node].left = upper;
+            update(node);
+            return {lower, node};
+        }
+    }
+
+    // Merges two treaps where every value in 'lower' is less than every value in 'upper'.
+    int32_t merge(int32_t lower, int32_t upper) {
+        if (lower == kNull) {
+            return upper;
+        }
+        if (upper == kNull) {
+            return lower;
+        }
+        if (_nodes[lower].priority > _nodes[upper].priority) {
+            _nodes[lower].right = merge(_nodes[lower].right, upper);
+            update(lower);
+            return lower;
+        } else {
+            _nodes[upper].left = merge(lower, _nodes[upper].left);
+            update(upper);
+            return upper;
+        }
+    }
+
+    int32_t newNode(double value) {
+        Node node{value, _random.nextUInt32(), 1, 1, kNull, kNull};
+        if (!_freeList.empty()) {
+            auto idx = _freeList.back();
+            _freeList.pop_back();
+            _nodes[idx] = node;
+            return idx;
+        }
+        _nodes.push_back(node);
+        return static_cast<int32_t>(_nodes.size() - 1);
+    }
+
+    void freeNode(int32_t node) {
+        _freeList.push_back(node);
+    }
+
+    // Nodes are kept in one vector and refer to their children by index, so a window that keeps
+    // sliding reuses the slots of removed values instead of allocating new ones.
+    std::vector<Node> _nodes;
+    std::vector<int32_t> _freeList;
+    int32_t _root = kNull;
+
+    // Priorities only need to be well spread, so a fixed seed keeps runs reproducible.
+    PseudoRandom _random{0x5eed};
+};
+
+}  // namespace mongo
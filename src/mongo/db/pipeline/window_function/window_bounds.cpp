@@ -143,6 +143,13 @@ bool WindowBounds::isUnbounded() const {
     return visit(unbounded, bounds);
 }
 
+bool WindowBounds::isLowerUnbounded() const {
+    auto lowerUnbounded = [](const auto& bounds) {
+        return holds_alternative<WindowBounds::Unbounded>(bounds.lower);
+    };
+    return visit(lowerUnbounded, bounds);
+}
+
 WindowBounds WindowBounds::parse(BSONElement args,
                                  const boost::optional<SortPattern>& sortBy,
                                  ExpressionContext* expCtx) {
@@ -97,6 +97,12 @@ struct WindowBounds {
      */
     bool isUnbounded() const;
 
+    /**
+     * Checks whether the lower bound is unbounded. Windows with any other lower bound have to
+     * remove documents as they slide, so only those need a removable window function.
+     */
+    bool isLowerUnbounded() const;
+
     /**
      * Parses bounds from the arguments object of a window-function expression.
      * For example, in:
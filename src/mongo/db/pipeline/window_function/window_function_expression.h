@@ -1104,7 +1104,10 @@ public:
           _ps(std::move(ps)),
           _method(method),
           _intializeExpr(std::move(initializeExpr)) {
-        expCtx->setSbeWindowCompatibility(SbeCompatibility::notCompatible);
+        // SBE only implements the removable form of these window functions.
+        if (_bounds.isLowerUnbounded()) {
+            expCtx->setSbeWindowCompatibility(SbeCompatibility::notCompatible);
+        }
     }
 
     Value serialize(const SerializationOptions& opts) const final;
@@ -1113,6 +1116,10 @@ public:
 
     std::unique_ptr<WindowFunctionState> buildRemovable() const final;
 
+    const std::vector<double>& ps() const {
+        return _ps;
+    }
+
 private:
     std::vector<double> _ps;
     PercentileMethodEnum _method;
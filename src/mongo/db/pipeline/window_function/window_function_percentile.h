@@ -31,6 +31,7 @@
 #pragma once
 
 #include "mongo/db/pipeline/percentile_algo_continuous.h"
+#include "mongo/db/pipeline/window_function/order_statistic_tree.h"
 #include "mongo/db/pipeline/window_function/window_function.h"
 
 namespace mongo {
@@ -45,8 +46,9 @@ public:
         if (!value.numeric()) {
             return;
         }
+        auto memUsageBefore = _values.memUsageBytes();
         _values.insert(value.coerceToDouble());
-        _memUsageTracker.add(sizeof(double));
+        _memUsageTracker.add(static_cast<int64_t>(_values.memUsageBytes() - memUsageBefore));
     }
 
     void remove(Value value) override {
@@ -55,12 +57,11 @@ public:
             return;
         }
 
-        auto iter = _values.find(value.coerceToDouble());
-        tassert(7455904,
-                "Cannot remove a value not tracked by WindowFunctionPercentile",
-                iter != _values.end());
-        _memUsageTracker.add(-static_cast<int64_t>(sizeof(double)));
-        _values.erase(iter);
+        auto memUsageBefore = _values.memUsageBytes();
+        bool removed = _values.erase(value.coerceToDouble());
+        tassert(7455904, "Cannot remove a value not tracked by WindowFunctionPercentile", removed);
+        _memUsageTracker.add(static_cast<int64_t>(_values.memUsageBytes()) -
+                             static_cast<int64_t>(memUsageBefore));
     }
 
     void reset() override {
@@ -71,30 +72,18 @@ public:
 protected:
     explicit WindowFunctionPercentileCommon(ExpressionContext* const expCtx,
                                             PercentileMethodEnum method)
-        : WindowFunctionState(expCtx),
-          _values(boost::container::flat_multiset<double>()),
-          _method(method) {}
+        : WindowFunctionState(expCtx), _method(method) {}
 
     Value computePercentile(double p) const {
-        // Calculate the rank.
-        const double n = _values.size();
-
-        // boost::container::flat_multiset stores the values in ascending order, so we don't need to
-        // sort them before finding the value at index 'rank'.
-        // boost::container::flat_multiset has random-access iterators, so std::advance has an
-        // expected runtime of O(1).
-        const double rank = DiscretePercentile::computeTrueRank(n, p);
-        auto it = _values.begin();
-        std::advance(it, rank);
-        return Value(*it);
+        // Calculate the rank and look up the value at that position in sorted order.
+        const auto rank = DiscretePercentile::computeTrueRank(_values.size(), p);
+        return Value(_values.select(rank));
     }
 
-    // Holds all the values in the window in ascending order.
-    // A boost::container::flat_multiset stores elements in a contiguous array, so iterating through
-    // the set is faster than iterating through a std::multiset which stores its elements typically
-    // as a binary search tree. Thus, using a boost::container::flat_multiset significantly improved
-    // performance.
-    boost::container::flat_multiset<double> _values;
+    // Holds all the values in the window. A sorted array makes reading a rank O(1) but every add
+    // and remove O(n) as the rest of the window shifts, which dominates for wide sliding windows.
+    // The order statistic tree makes all three O(log n).
+    OrderStatisticTree _values;
     PercentileMethodEnum _method;
 };
 
@@ -93,44 +93,63 @@ void WindowFunctionPercentileBenchmarkFixture::removable_unbounded_percentile(
     }
 }
 
-// This benchmark is mimicking the behavior of computing $percentile for a ["current", 100]
-// window. In a ["current", 100] window, the first window will add itself and the next 100 elements
-// in 'inputs' to the window function. Then for each following window, the previous current element
-// will be removed, and a new element (100 indexes away from the new current element) will be added.
-// Then the percentile will be recalculated. We will not add any elements if the index is out of
-// bounds, resulting in smaller windows towards the end of 'inputs'.
-void WindowFunctionPercentileBenchmarkFixture::removable_bounded_percentile(
-    benchmark::State& state, PercentileMethodEnum method, std::vector<double> ps) {
-    // Generate the data.
-    const vector<double> inputs = generateNormalData(dataSizeLarge);
-    auto expCtx = make_intrusive<ExpressionContextForTest>();
-
-    // Run the test.
+namespace {
+// Mimics computing a window function over a ["current", 'windowSize'] window. The first window
+// adds itself and the next 'windowSize' elements in 'inputs' to the window function. Then for each
+// following window, the previous current element is removed, and a new element ('windowSize'
+// indexes away from the new current element) is added, before the value is recalculated. We will
+// not add any elements if the index is out of bounds, resulting in smaller windows towards the end
+// of 'inputs'.
+template <typename MakeWindowFunction>
+void runBoundedWindow(benchmark::State& state,
+                      const vector<double>& inputs,
+                      size_t windowSize,
+                      MakeWindowFunction makeWindowFunction) {
     for (auto keepRunning : state) {
-        auto w = WindowFunctionPercentile::create(expCtx.get(), method, ps);
+        auto w = makeWindowFunction();
 
-        // Calculate the percentile for a ["current", 100] window for each input.
-        for (size_t i = 0; i < dataSizeLarge; i++) {
-            // Add the first value and the next 100 to the window.
+        for (size_t i = 0; i < inputs.size(); i++) {
             if (i == 0) {
-                for (size_t j = 0; j < 101; j++) {
+                for (size_t j = 0; j <= windowSize && j < inputs.size(); j++) {
                     w->add(Value(inputs[j]));
                 }
-                benchmark::DoNotOptimize(w->getValue());
             } else {
                 // Remove the previous current value.
-                double valToRemove = inputs[i - 1];
-                w->remove(Value(valToRemove));
+                w->remove(Value(inputs[i - 1]));
                 // If possible, add the new value.
-                if (i + 100 < dataSizeLarge - 1) {
-                    w->add(Value(inputs[i + 100]));
+                if (i + windowSize < inputs.size() - 1) {
+                    w->add(Value(inputs[i + windowSize]));
                 }
-                benchmark::DoNotOptimize(w->getValue());
             }
+            benchmark::DoNotOptimize(w->getValue());
         }
         benchmark::ClobberMemory();
     }
 }
+}  // namespace
+
+void WindowFunctionPercentileBenchmarkFixture::removable_bounded_percentile(
+    benchmark::State& state,
+    PercentileMethodEnum method,
+    std::vector<double> ps,
+    size_t windowSize) {
+    const vector<double> inputs = generateNormalData(dataSizeLarge);
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+
+    runBoundedWindow(state, inputs, windowSize, [&] {
+        return WindowFunctionPercentile::create(expCtx.get(), method, ps);
+    });
+}
+
+void WindowFunctionPercentileBenchmarkFixture::removable_bounded_median(
+    benchmark::State& state, PercentileMethodEnum method, size_t windowSize) {
+    const vector<double> inputs = generateNormalData(dataSizeLarge);
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+
+    runBoundedWindow(state, inputs, windowSize, [&] {
+        return WindowFunctionMedian::create(expCtx.get(), method);
+    });
+}
 
 BENCHMARK_WINDOW_PERCENTILE(WindowFunctionPercentileBenchmarkFixture);
 }  // namespace mongo
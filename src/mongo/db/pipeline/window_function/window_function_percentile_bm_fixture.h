@@ -43,7 +43,11 @@ public:
                                         std::vector<double> ps);
     void removable_bounded_percentile(benchmark::State& state,
                                       PercentileMethodEnum method,
-                                      std::vector<double> ps);
+                                      std::vector<double> ps,
+                                      size_t windowSize = 100);
+    void removable_bounded_median(benchmark::State& state,
+                                  PercentileMethodEnum method,
+                                  size_t windowSize);
 
     static constexpr int dataSizeLarge = 100'000;
 };
@@ -77,6 +81,16 @@ public:
         removable_bounded_percentile(state,                                                 \
                                      PercentileMethodEnum::kApproximate,                    \
                                      {.1, .47, .88, .05, .33, .999, .2, .59, .9, .7});      \
+    }                                                                                       \
+    BENCHMARK_F(Fixture, percentile_bounded_wide_mid_p)(benchmark::State & state) {         \
+        removable_bounded_percentile(                                                       \
+            state, PercentileMethodEnum::kDiscrete, {.55}, 10'000);                         \
+    }                                                                                       \
+    BENCHMARK_F(Fixture, median_bounded)(benchmark::State & state) {                        \
+        removable_bounded_median(state, PercentileMethodEnum::kDiscrete, 100);              \
+    }                                                                                       \
+    BENCHMARK_F(Fixture, median_bounded_wide)(benchmark::State & state) {                   \
+        removable_bounded_median(state, PercentileMethodEnum::kDiscrete, 10'000);           \
     }
 
 }  // namespace mongo
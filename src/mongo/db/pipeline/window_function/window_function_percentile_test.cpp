@@ -0,0 +1,208 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/window_function/order_statistic_tree.h"
+#include "mongo/db/pipeline/window_function/window_function_percentile.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/framework.h"
+#include "mongo/util/intrusive_counter.h"
+
+namespace mongo {
+namespace {
+
+TEST(OrderStatisticTreeTest, SelectReturnsValuesInSortedOrder) {
+    OrderStatisticTree tree;
+    ASSERT_TRUE(tree.empty());
+    for (double v : {5.0, 1.0, 3.0, 3.0, -2.0}) {
+        tree.insert(v);
+    }
+    ASSERT_EQ(tree.size(), 5U);
+    std::vector<double> expected = {-2.0, 1.0, 3.0, 3.0, 5.0};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(tree.select(i), expected[i]);
+    }
+}
+
+TEST(OrderStatisticTreeTest, EraseRemovesOneCopy) {
+    OrderStatisticTree tree;
+    for (double v : {2.0, 2.0, 1.0}) {
+        tree.insert(v);
+    }
+    ASSERT_FALSE(tree.erase(7.0));
+    ASSERT_TRUE(tree.erase(2.0));
+    ASSERT_EQ(tree.size(), 2U);
+    ASSERT_EQ(tree.select(1), 2.0);
+    ASSERT_TRUE(tree.erase(2.0));
+    ASSERT_FALSE(tree.erase(2.0));
+    ASSERT_TRUE(tree.erase(1.0));
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(OrderStatisticTreeTest, NaNSortsFirstAndCanBeErased) {
+    OrderStatisticTree tree;
+    tree.insert(1.0);
+    tree.insert(std::numeric_limits<double>::quiet_NaN());
+    ASSERT_TRUE(std::isnan(tree.select(0)));
+    ASSERT_EQ(tree.select(1), 1.0);
+    ASSERT_TRUE(tree.erase(std::numeric_limits<double>::quiet_NaN()));
+    ASSERT_EQ(tree.size(), 1U);
+}
+
+TEST(OrderStatisticTreeTest, MemoryUsageCountsOnlyDistinctValuesInTheTree) {
+    OrderStatisticTree tree;
+    ASSERT_EQ(tree.memUsageBytes(), 0U);
+    tree.insert(1.0);
+    auto oneValue = tree.memUsageBytes();
+    ASSERT_GT(oneValue, 0U);
+
+    // Another copy of a value only bumps its count.
+    tree.insert(1.0);
+    ASSERT_EQ(tree.memUsageBytes(), oneValue);
+    tree.insert(2.0);
+    ASSERT_EQ(tree.memUsageBytes(), 2 * oneValue);
+
+    ASSERT_TRUE(tree.erase(2.0));
+    ASSERT_EQ(tree.memUsageBytes(), oneValue);
+    ASSERT_TRUE(tree.erase(1.0));
+    ASSERT_EQ(tree.memUsageBytes(), oneValue);
+    ASSERT_TRUE(tree.erase(1.0));
+    ASSERT_EQ(tree.memUsageBytes(), 0U);
+
+    // A freed slot is reused.
+    tree.insert(3.0);
+    ASSERT_EQ(tree.memUsageBytes(), oneValue);
+}
+
+TEST(OrderStatisticTreeTest, MatchesSortedVectorOverSlidingWindow) {
+    PseudoRandom random(1);
+    std::vector<double> inputs;
+    for (int i = 0; i < 2'000; ++i) {
+        // Draw from a small range so that duplicates are common.
+        inputs.push_back(random.nextInt32(100));
+    }
+
+    const size_t windowSize = 50;
+    OrderStatisticTree tree;
+    std::vector<double> sorted;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        tree.insert(inputs[i]);
+        sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), inputs[i]), inputs[i]);
+        if (i >= windowSize) {
+            auto removed = inputs[i - windowSize];
+            ASSERT_TRUE(tree.erase(removed));
+            sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), removed));
+        }
+
+        ASSERT_EQ(tree.size(), sorted.size());
+        for (size_t rank = 0; rank < sorted.size(); ++rank) {
+            ASSERT_EQ(tree.select(rank), sorted[rank]);
+        }
+    }
+}
+
+class WindowFunctionPercentileTest : public AggregationContextFixture {
+public:
+    WindowFunctionPercentileTest()
+        : expCtx(getExpCtx()),
+          percentile(expCtx.get(), PercentileMethodEnum::kDiscrete, {0.0, 0.5, 1.0}),
+          median(expCtx.get(), PercentileMethodEnum::kDiscrete) {}
+
+    boost::intrusive_ptr<ExpressionContext> expCtx;
+    WindowFunctionPercentile percentile;
+    WindowFunctionMedian median;
+};
+
+TEST_F(WindowFunctionPercentileTest, EmptyWindowReturnsNulls) {
+    ASSERT_VALUE_EQ(percentile.getValue(), Value(BSON_ARRAY(BSONNULL << BSONNULL << BSONNULL)));
+    ASSERT_VALUE_EQ(median.getValue(), Value(BSONNULL));
+
+    percentile.add(Value(1));
+    percentile.remove(Value(1));
+    ASSERT_VALUE_EQ(percentile.getValue(), Value(BSON_ARRAY(BSONNULL << BSONNULL << BSONNULL)));
+}
+
+TEST_F(WindowFunctionPercentileTest, IgnoresNonNumericValues) {
+    for (auto&& v : {Value(3), Value("str"_sd), Value(1LL), Value(2.0)}) {
+        percentile.add(v);
+        median.add(v);
+    }
+    ASSERT_VALUE_EQ(percentile.getValue(), Value(BSON_ARRAY(1.0 << 2.0 << 3.0)));
+    ASSERT_VALUE_EQ(median.getValue(), Value(2.0));
+
+    percentile.remove(Value(3));
+    percentile.remove(Value("str"_sd));
+    median.remove(Value(3));
+    median.remove(Value("str"_sd));
+    ASSERT_VALUE_EQ(percentile.getValue(), Value(BSON_ARRAY(1.0 << 1.0 << 2.0)));
+    ASSERT_VALUE_EQ(median.getValue(), Value(1.0));
+}
+
+TEST_F(WindowFunctionPercentileTest, MemoryUsageIsReleasedOnReset) {
+    auto initialMemUsage = percentile.getApproximateSize();
+    for (int i = 0; i < 100; ++i) {
+        percentile.add(Value(i));
+    }
+    ASSERT_GT(percentile.getApproximateSize(), initialMemUsage);
+
+    percentile.reset();
+    ASSERT_EQ(percentile.getApproximateSize(), initialMemUsage);
+}
+
+TEST_F(WindowFunctionPercentileTest, MemoryUsageIsReleasedOnRemove) {
+    auto initialMemUsage = percentile.getApproximateSize();
+    for (int i = 0; i < 100; ++i) {
+        percentile.add(Value(i));
+    }
+    auto fullMemUsage = percentile.getApproximateSize();
+    ASSERT_GT(fullMemUsage, initialMemUsage);
+
+    for (int i = 0; i < 50; ++i) {
+        percentile.remove(Value(i));
+    }
+    ASSERT_LT(percentile.getApproximateSize(), fullMemUsage);
+    for (int i = 50; i < 100; ++i) {
+        percentile.remove(Value(i));
+    }
+    ASSERT_EQ(percentile.getApproximateSize(), initialMemUsage);
+}
+
+}  // namespace
+}  // namespace mongo
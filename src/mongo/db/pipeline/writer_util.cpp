@@ -29,9 +29,46 @@
 
 #include "mongo/db/pipeline/writer_util.h"
 
+#include <algorithm>
+
+#include "mongo/base/init.h"  // IWYU pragma: keep
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/write_ops/write_ops_gen.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/write_block_bypass.h"
 
 namespace mongo {
+namespace {
+struct WriterFlushPool {
+    std::unique_ptr<ThreadPool> pool;
+    bool joined = false;
+};
+
+const auto getWriterFlushPoolDecoration = ServiceContext::declareDecoration<WriterFlushPool>();
+
+const ServiceContext::ConstructorActionRegisterer writerFlushPoolRegisterer{
+    "WriterFlushPool",
+    [](ServiceContext* svcCtx) {
+        ThreadPool::Options options;
+        options.poolName = "DocumentSourceWriterFlushPool";
+        options.threadNamePrefix = "WriterFlush";
+        options.minThreads = 0;
+        options.maxThreads = 64;
+        options.onCreateThread = [svcCtx](const std::string& name) {
+            Client::initThread(name, svcCtx->getService(ClusterRole::ShardServer));
+        };
+        auto& flushPool = getWriterFlushPoolDecoration(svcCtx);
+        flushPool.pool = std::make_unique<ThreadPool>(options);
+        flushPool.pool->startup();
+    },
+    [](ServiceContext* svcCtx) {
+        shutdownWriterFlushPool(svcCtx);
+    }};
+}  // namespace
 
 BatchedCommandRequest makeInsertCommand(const NamespaceString& outputNs,
                                         bool bypassDocumentValidation) {
@@ -45,4 +82,87 @@ BatchedCommandRequest makeInsertCommand(const NamespaceString& outputNs,
     return BatchedCommandRequest(std::move(insertOp));
 }
 
+bool canFlushWriterBatchesInBackground(const ExpressionContext& expCtx,
+                                       const NamespaceString& outputNs) {
+    // Writes on a shard server or router go through the cluster write path, which already splits
+    // each batch per destination shard and depends on the state of the originating client.
+    if (expCtx.getInRouter() || !serverGlobalParams.clusterRole.has(ClusterRole::None)) {
+        return false;
+    }
+    auto opCtx = expCtx.getOperationContext();
+    if (opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+    // A secondary forwards its writes to the primary on behalf of the user's client.
+    Lock::ResourceLock rstl(opCtx, resourceIdReplicationStateTransitionLock, MODE_IX);
+    return repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, outputNs);
+}
+
+ThreadPool* getWriterFlushPool(ServiceContext* svcCtx) {
+    return getWriterFlushPoolDecoration(svcCtx).pool.get();
+}
+
+void shutdownWriterFlushPool(ServiceContext* svcCtx) {
+    auto& flushPool = getWriterFlushPoolDecoration(svcCtx);
+    if (!flushPool.pool || flushPool.joined) {
+        return;
+    }
+    flushPool.pool->shutdown();
+    flushPool.pool->join();
+    flushPool.joined = true;
+}
+
+WriterFlushGroup::WriterFlushGroup(OperationContext* parentOpCtx)
+    : _deadline(parentOpCtx->getDeadline()),
+      _timeoutError(parentOpCtx->getTimeoutError()),
+      _writeBlockBypass(WriteBlockBypass::get(parentOpCtx).isWriteBlockBypassEnabled()),
+      _impersonatedUser(rpc::getAuthDataToImpersonatedUserMetadata(parentOpCtx)) {}
+
+WriterFlushGroup::FlushOperation WriterFlushGroup::makeOperationContext() {
+    auto client = Client::getCurrent();
+    auto opCtx = client->makeOperationContext();
+    if (_deadline != Date_t::max()) {
+        opCtx->setDeadlineByDate(_deadline, _timeoutError);
+    }
+    WriteBlockBypass::get(opCtx.get()).set(_writeBlockBypass);
+    rpc::setImpersonatedUserMetadata(opCtx.get(), _impersonatedUser);
+    return FlushOperation(this, std::move(opCtx));
+}
+
+WriterFlushGroup::FlushOperation::FlushOperation(WriterFlushGroup* group,
+                                                 ServiceContext::UniqueOperationContext opCtx)
+    : _group(group), _opCtx(std::move(opCtx)) {
+    // Audit records of the flush name the users of the stage's operation.
+    if (_group->_impersonatedUser && _group->_impersonatedUser->getUser()) {
+        AuthorizationSession::get(_opCtx->getClient())
+            ->setImpersonatedUserData(*_group->_impersonatedUser->getUser(),
+                                      _group->_impersonatedUser->getRoles());
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_group->_mutex);
+    if (_group->_killCode) {
+        _opCtx->markKilled(*_group->_killCode);
+    }
+    _group->_opCtxs.push_back(_opCtx.get());
+}
+
+WriterFlushGroup::FlushOperation::~FlushOperation() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_group->_mutex);
+        auto& opCtxs = _group->_opCtxs;
+        opCtxs.erase(std::find(opCtxs.begin(), opCtxs.end(), _opCtx.get()));
+    }
+    // The flush threads are pooled, so their Client must not keep the impersonated users.
+    AuthorizationSession::get(_opCtx->getClient())->clearImpersonatedUserData();
+}
+
+void WriterFlushGroup::killAll(ErrorCodes::Error killCode) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _killCode = killCode;
+    for (auto opCtx : _opCtxs) {
+        ClientLock clientLock(opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, killCode);
+    }
+}
+
 }  // namespace mongo
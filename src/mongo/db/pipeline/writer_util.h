@@ -31,11 +31,93 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/rpc/metadata/impersonated_user_metadata.h"
 #include "mongo/s/write_ops/batched_command_request.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class ExpressionContext;
+
 BatchedCommandRequest makeInsertCommand(const NamespaceString& outputNs,
                                         bool bypassDocumentValidation);
 
+/**
+ * Returns true if a writer stage may hand its batches for 'outputNs' to background flushers. This
+ * is only the case for writes that are applied to local collections on a mongod which is not part
+ * of a sharded cluster, outside of a multi-document transaction.
+ */
+bool canFlushWriterBatchesInBackground(const ExpressionContext& expCtx,
+                                       const NamespaceString& outputNs);
+
+/**
+ * Returns the pool of 'svcCtx' whose threads flush writer stage batches in the background. Each
+ * thread has its own Client, so a background flush runs under its own OperationContext. Once the
+ * pool is shut down, scheduled flushes are called with a ShutdownInProgress status instead.
+ */
+ThreadPool* getWriterFlushPool(ServiceContext* svcCtx);
+
+/**
+ * Shuts down the writer flush pool of 'svcCtx' and waits for the flushes in progress to finish.
+ * Must be called at shutdown after operations have been killed and before the storage engine is
+ * shut down. Later calls do nothing.
+ */
+void shutdownWriterFlushPool(ServiceContext* svcCtx);
+
+/**
+ * Tracks the background flushes of one writer stage. Each flush runs under an OperationContext that
+ * carries over the deadline, write block bypass and impersonated users of the stage's operation,
+ * and that can be killed when that operation fails or is interrupted.
+ */
+class WriterFlushGroup {
+public:
+    /** An OperationContext for one flush, which the group can kill until it is destroyed. */
+    class FlushOperation {
+    public:
+        FlushOperation(WriterFlushGroup* group, ServiceContext::UniqueOperationContext opCtx);
+        ~FlushOperation();
+
+        FlushOperation(const FlushOperation&) = delete;
+        FlushOperation& operator=(const FlushOperation&) = delete;
+
+        OperationContext* get() const {
+            return _opCtx.get();
+        }
+
+    private:
+        WriterFlushGroup* _group;
+        ServiceContext::UniqueOperationContext _opCtx;
+    };
+
+    /** Must be constructed on the thread that runs 'parentOpCtx'. */
+    explicit WriterFlushGroup(OperationContext* parentOpCtx);
+
+    /**
+     * Makes the OperationContext for a flush on the current thread's Client. If the group has
+     * already been killed, so is the returned OperationContext.
+     */
+    FlushOperation makeOperationContext();
+
+    /** Kills the flushes that are running or yet to start with 'killCode'. */
+    void killAll(ErrorCodes::Error killCode);
+
+private:
+    const Date_t _deadline;
+    const ErrorCodes::Error _timeoutError;
+    const bool _writeBlockBypass;
+    const boost::optional<rpc::ImpersonatedUserMetadata> _impersonatedUser;
+
+    stdx::mutex _mutex;
+    std::vector<OperationContext*> _opCtxs;
+    boost::optional<ErrorCodes::Error> _killCode;
+};
+
 }  // namespace mongo
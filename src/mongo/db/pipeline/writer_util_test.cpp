@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/pipeline/writer_util.h"
+
+#include "mongo/base/error_codes.h"
+#include "mongo/base/status.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/assert.h"
+#include "mongo/unittest/framework.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace {
+
+class WriterFlushGroupTest : public ServiceContextTest {
+public:
+    /**
+     * Runs a flush on the writer flush pool that makes its OperationContext in 'group', waits for
+     * 'proceed' if given, and fails with the status the OperationContext was killed with.
+     */
+    Future<void> runFlush(WriterFlushGroup& group, Notification<void>* proceed = nullptr) {
+        auto [promise, future] = makePromiseFuture<void>();
+        getWriterFlushPool(getServiceContext())
+            ->schedule([&group, proceed, promise = std::move(promise)](Status status) mutable {
+                promise.setWith([&] {
+                    uassertStatusOK(status);
+                    auto flushOpCtx = group.makeOperationContext();
+                    if (proceed) {
+                        proceed->get();
+                    }
+                    flushOpCtx.get()->checkForInterrupt();
+                });
+            });
+        return std::move(future);
+    }
+};
+
+TEST_F(WriterFlushGroupTest, FlushesAreNotKilledByDefault) {
+    auto opCtx = makeOperationContext();
+    WriterFlushGroup group(opCtx.get());
+    ASSERT_OK(runFlush(group).getNoThrow());
+}
+
+TEST_F(WriterFlushGroupTest, KillAllKillsRunningAndLaterFlushes) {
+    auto opCtx = makeOperationContext();
+    WriterFlushGroup group(opCtx.get());
+
+    Notification<void> proceed;
+    auto running = runFlush(group, &proceed);
+    group.killAll(ErrorCodes::Interrupted);
+    proceed.set();
+
+    // Whether the kill reached the flush while it ran or when it made its OperationContext, the
+    // flush sees it.
+    ASSERT_EQ(running.getNoThrow(), ErrorCodes::Interrupted);
+    ASSERT_EQ(runFlush(group).getNoThrow(), ErrorCodes::Interrupted);
+}
+
+TEST_F(WriterFlushGroupTest, FlushesInheritTheParentDeadline) {
+    auto opCtx = makeOperationContext();
+    opCtx->setDeadlineByDate(Date_t::now() - Milliseconds(1), ErrorCodes::MaxTimeMSExpired);
+    WriterFlushGroup group(opCtx.get());
+    ASSERT_EQ(runFlush(group).getNoThrow(), ErrorCodes::MaxTimeMSExpired);
+}
+
+TEST_F(WriterFlushGroupTest, FlushesScheduledAfterShutdownFail) {
+    auto opCtx = makeOperationContext();
+    WriterFlushGroup group(opCtx.get());
+
+    shutdownWriterFlushPool(getServiceContext());
+    ASSERT_EQ(runFlush(group).getNoThrow(), ErrorCodes::ShutdownInProgress);
+
+    // A second shutdown, as the ServiceContext does on destruction, does nothing.
+    shutdownWriterFlushPool(getServiceContext());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -105,6 +105,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/accumulator_multi.h"
+#include "mongo/db/pipeline/accumulator_percentile.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -3766,6 +3767,32 @@ SbExpr getDefaultValueExpr(StageBuilderState& state, const WindowFunctionStateme
     }
 }
 
+/**
+ * Returns a constant array holding one element per percentile requested by a $percentile window
+ * function: the requested 'p' values, or nulls when 'makeNulls' is true.
+ */
+SbExpr makePercentilesExpr(StageBuilderState& state,
+                           const WindowFunctionStatement& wfStmt,
+                           bool makeNulls) {
+    SbExprBuilder b(state);
+
+    auto expr = dynamic_cast<window_function::ExpressionQuantile<AccumulatorPercentile>*>(
+        wfStmt.expr.get());
+    tassert(10745805, "Expected a $percentile window function", expr);
+
+    auto [tag, val] = sbe::value::makeNewArray();
+    auto arr = sbe::value::getArrayView(val);
+    arr->reserve(expr->ps().size());
+    for (double p : expr->ps()) {
+        if (makeNulls) {
+            arr->push_back(sbe::value::TypeTags::Null, 0);
+        } else {
+            arr->push_back(sbe::value::TypeTags::NumberDouble, sbe::value::bitcastFrom<double>(p));
+        }
+    }
+    return b.makeConstant(tag, val);
+}
+
 std::tuple<bool, PlanStageReqs> computeChildReqsForWindow(const PlanStageReqs& reqs,
                                                           const WindowNode* windowNode) {
     auto reqFields = reqs.getFields();
@@ -4481,6 +4508,10 @@ public:
         } else if (isTopBottomN(outputField)) {
             finalizeInputs = std::make_unique<FinalizeTopBottomNInputs>(
                 SbExpr{SbSlot{state.getSortSpecSlot(&outputField)}});
+        } else if (outputField.expr->getOpName() == AccumulatorPercentile::kName) {
+            tassert(10745806, "$percentile is expected to be removable", removable);
+            finalizeInputs = std::make_unique<FinalizeWindowPercentileInputs>(
+                makePercentilesExpr(state, outputField, false /* makeNulls */));
         }
 
         // Build finalize.
@@ -4506,6 +4537,8 @@ public:
                 return b.makeConstant(tag, val);
             } else if (opName == "$shift") {
                 return getDefaultValueExpr(state, outputField);
+            } else if (opName == AccumulatorPercentile::kName) {
+                return makePercentilesExpr(state, outputField, true /* makeNulls */);
             } else {
                 return b.makeNullConstant();
             }
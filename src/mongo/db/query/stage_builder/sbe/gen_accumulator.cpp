@@ -143,6 +143,10 @@ AccumInputsPtr FinalizeWindowFirstLastInputs::clone() const {
     return std::make_unique<FinalizeWindowFirstLastInputs>(inputExpr.clone(), defaultVal.clone());
 }
 
+AccumInputsPtr FinalizeWindowPercentileInputs::clone() const {
+    return std::make_unique<FinalizeWindowPercentileInputs>(ps.clone());
+}
+
 AccumInputsPtr CombineAggsTopBottomNInputs::clone() const {
     return std::make_unique<CombineAggsTopBottomNInputs>(sortSpec.clone());
 }
@@ -341,6 +341,14 @@ struct FinalizeWindowFirstLastInputs : public AccumInputs {
     SbExpr defaultVal;
 };
 
+struct FinalizeWindowPercentileInputs : public AccumInputs {
+    FinalizeWindowPercentileInputs(SbExpr ps) : ps(std::move(ps)) {}
+
+    AccumInputsPtr clone() const final;
+
+    SbExpr ps;
+};
+
 struct CombineAggsTopBottomNInputs : public AccumInputs {
     CombineAggsTopBottomNInputs(SbExpr sortSpec) : sortSpec(std::move(sortSpec)) {}
 
@@ -429,6 +429,7 @@ public:
     void visit(const ExpressionInternalOwningShard* expr) final {}
     void visit(const ExpressionInternalIndexKey* expr) final {}
     void visit(const ExpressionInternalKeyStringValue* expr) final {}
+    void visit(const ExpressionInternalSharedSubexpression* expr) final {}
 
 private:
     ExpressionVisitorContext* _context;
@@ -606,6 +607,7 @@ public:
     void visit(const ExpressionInternalOwningShard* expr) final {}
     void visit(const ExpressionInternalIndexKey* expr) final {}
     void visit(const ExpressionInternalKeyStringValue* expr) final {}
+    void visit(const ExpressionInternalSharedSubexpression* expr) final {}
 
 private:
     ExpressionVisitorContext* _context;
@@ -3637,6 +3639,10 @@ public:
         unsupportedExpression(expr->getOpName());
     }
 
+    void visit(const ExpressionInternalSharedSubexpression* expr) final {
+        // The child's result is already on the stack and is the result of this expression.
+    }
+
 private:
     /**
      * Shared logic for $round and $trunc expressions
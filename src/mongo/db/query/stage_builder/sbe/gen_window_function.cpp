@@ -29,6 +29,7 @@
 
 #include "mongo/db/query/stage_builder/sbe/gen_window_function.h"
 
+#include "mongo/db/pipeline/accumulator_percentile.h"
 #include "mongo/db/query/stage_builder/sbe/sbexpr_helpers.h"
 
 namespace mongo::stage_builder {
@@ -823,6 +824,45 @@ SbExpr buildWindowFinalizeBottom(const WindowOp& op, StageBuilderState& state, S
                        b.makeInt32Constant(0)));
 }
 
+SbExpr::Vector buildWindowAddPercentile(const WindowOp& op,
+                                        std::unique_ptr<AddSingleInput> inputs,
+                                        StageBuilderState& state) {
+    SbExprBuilder b(state);
+    return SbExpr::makeSeq(
+        b.makeFunction("aggRemovablePercentileAdd", std::move(inputs->inputExpr)));
+}
+
+SbExpr::Vector buildWindowRemovePercentile(const WindowOp& op,
+                                           std::unique_ptr<AddSingleInput> inputs,
+                                           StageBuilderState& state) {
+    SbExprBuilder b(state);
+    return SbExpr::makeSeq(
+        b.makeFunction("aggRemovablePercentileRemove", std::move(inputs->inputExpr)));
+}
+
+SbExpr buildWindowFinalizePercentile(const WindowOp& op,
+                                     std::unique_ptr<FinalizeWindowPercentileInputs> inputs,
+                                     StageBuilderState& state,
+                                     SbSlotVector slots) {
+    SbExprBuilder b(state);
+
+    tassert(10745803, "Expected a single slot", slots.size() == 1);
+    return b.makeFunction("aggRemovablePercentileFinalize", slots[0], std::move(inputs->ps));
+}
+
+SbExpr buildWindowFinalizeMedian(const WindowOp& op, StageBuilderState& state, SbSlotVector slots) {
+    SbExprBuilder b(state);
+
+    tassert(10745804, "Expected a single slot", slots.size() == 1);
+    auto [psTag, psVal] = sbe::value::makeNewArray();
+    sbe::value::getArrayView(psVal)->push_back(sbe::value::TypeTags::NumberDouble,
+                                               sbe::value::bitcastFrom<double>(0.5));
+    return b.makeFunction(
+        "getElement",
+        b.makeFunction("aggRemovablePercentileFinalize", slots[0], b.makeConstant(psTag, psVal)),
+        b.makeInt32Constant(0));
+}
+
 static const StringDataMap<WindowOpInfo> windowOpInfoMap = {
     // AddToSet
     {AccumulatorAddToSet::kName,
@@ -925,6 +965,12 @@ static const StringDataMap<WindowOpInfo> windowOpInfoMap = {
                   .buildInit = makeBuildFn(&buildWindowInitializeMinMaxN),
                   .buildFinalize = makeBuildFn(&buildWindowFinalizeMaxN)}},
 
+    // Median
+    {AccumulatorMedian::kName,
+     WindowOpInfo{.buildAddAggs = makeBuildFn(&buildWindowAddPercentile),
+                  .buildRemoveAggs = makeBuildFn(&buildWindowRemovePercentile),
+                  .buildFinalize = makeBuildFn(&buildWindowFinalizeMedian)}},
+
     // Min
     {AccumulatorMin::kName,
      WindowOpInfo{.buildAddAggs = makeBuildFn(&buildWindowAddMinMaxN),
@@ -939,6 +985,12 @@ static const StringDataMap<WindowOpInfo> windowOpInfoMap = {
                   .buildInit = makeBuildFn(&buildWindowInitializeMinMaxN),
                   .buildFinalize = makeBuildFn(&buildWindowFinalizeMinN)}},
 
+    // Percentile
+    {AccumulatorPercentile::kName,
+     WindowOpInfo{.buildAddAggs = makeBuildFn(&buildWindowAddPercentile),
+                  .buildRemoveAggs = makeBuildFn(&buildWindowRemovePercentile),
+                  .buildFinalize = makeBuildFn(&buildWindowFinalizePercentile)}},
+
     // Push
     {"$push",
      WindowOpInfo{.buildAddAggs = makeBuildFn(&buildWindowAddPush),
@@ -815,6 +815,61 @@ TEST_F(SortedDataInterfaceTest, Locate4) {
     }
 }
 
+// Seeks repeatedly on the same cursor in ascending order. Consecutive seeks may land on the key the
+// cursor is already positioned on or a few entries past it, and must give the same results as a
+// fresh cursor.
+TEST_F(SortedDataInterfaceTest, LocateAscendingSeeksOnSameCursor) {
+    const auto sorted(
+        harnessHelper()->newSortedDataInterface(opCtx(), /*unique=*/false, /*partial=*/false));
+
+    auto buildEntry = [](int i) {
+        return IndexKeyEntry(BSON("" << i), RecordId(1, i * 2));
+    };
+
+    {
+        StorageWriteTransaction txn(recoveryUnit());
+        for (int i = 0; i < 20; i += 2) {
+            auto entry = buildEntry(i);
+            ASSERT_SDI_INSERT_OK(
+                sorted->insert(opCtx(), makeKeyString(sorted.get(), entry.key, entry.loc), true));
+        }
+        txn.commit();
+    }
+
+    auto seek = [&](SortedDataInterface::Cursor* cursor, int i) {
+        return cursor->seek(
+            makeKeyStringForSeek(sorted.get(), BSON("" << i), true, true).finishAndGetBuffer());
+    };
+
+    const auto cursor(sorted->newCursor(opCtx()));
+    ASSERT_EQ(seek(cursor.get(), 3), buildEntry(4));
+    // Lands between the previous seek key and the current position.
+    ASSERT_EQ(seek(cursor.get(), 4), buildEntry(4));
+    // Lands a few entries past the current position.
+    ASSERT_EQ(seek(cursor.get(), 9), buildEntry(10));
+    ASSERT_EQ(cursor->next(), buildEntry(12));
+    // The cursor moved since the last seek, so the keys it passed over must still be found.
+    ASSERT_EQ(seek(cursor.get(), 11), buildEntry(12));
+    ASSERT_EQ(seek(cursor.get(), 10), buildEntry(10));
+    // Far past the current position.
+    ASSERT_EQ(seek(cursor.get(), 17), buildEntry(18));
+    ASSERT_EQ(seek(cursor.get(), 19), boost::none);
+
+    // Keys written by our own unit of work behind the current position must be visible to the
+    // next seek.
+    ASSERT_EQ(seek(cursor.get(), 5), buildEntry(6));
+    {
+        StorageWriteTransaction txn(recoveryUnit());
+        auto entry = buildEntry(5);
+        ASSERT_SDI_INSERT_OK(
+            sorted->insert(opCtx(), makeKeyString(sorted.get(), entry.key, entry.loc), true));
+        ASSERT_EQ(seek(cursor.get(), 5), buildEntry(5));
+        txn.commit();
+    }
+    ASSERT_EQ(seek(cursor.get(), 5), buildEntry(5));
+    ASSERT_EQ(cursor->next(), buildEntry(6));
+}
+
 
 }  // namespace
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index_cursor_generic.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/db/transaction_resources.h"
@@ -875,7 +876,8 @@ public:
           _indexName(idx.indexName()),
           _collectionUUID(idx.getCollectionUUID()),
           _metrics(&ResourceConsumption::MetricsCollector::get(opCtx)),
-          _key(idx.getKeyStringVersion()) {
+          _key(idx.getKeyStringVersion()),
+          _lastSeekKey(idx.getKeyStringVersion()) {
         // Allow overwrite because it's faster and this is a read-only cursor.
         constexpr bool allowOverwrite = true;
         _cursor.emplace(*WiredTigerRecoveryUnit::get(shard_role_details::getRecoveryUnit(_opCtx)),
@@ -907,6 +909,7 @@ public:
         if (key.isEmpty()) {
             // This means scan to end of index.
             _endPosition.reset();
+            _endPositionChangedSinceSeek = true;
             return;
         }
 
@@ -926,11 +929,13 @@ public:
         if (keyString.isEmpty()) {
             // This means scan to end of index.
             _endPosition.reset();
+            _endPositionChangedSinceSeek = true;
             return;
         }
 
         auto newEndPosition = std::make_unique<key_string::Value>(keyString);
         _endPosition.swap(newEndPosition);
+        _endPositionChangedSinceSeek = true;
     }
 
     boost::optional<IndexKeyEntry> seek(
@@ -1093,10 +1098,83 @@ protected:
             _kvView.reset();
         }
 
+        _endPositionChangedSinceSeek = false;
         const WiredTigerItem searchKey(query.data(), query.size());
         return seekWTCursorInternal(searchKey);
     }
 
+    /**
+     * Attempts to satisfy a seek for 'query' from the position the cursor is already on instead of
+     * searching down from the root of the tree. This pays off for sequences of ascending (or, for
+     * reverse cursors, descending) seeks that land close to each other, which is the common shape
+     * of equality lookups on the leading fields of a compound index.
+     *
+     * Returns true if the cursor is positioned on the first key at or after 'query', or is at EOF
+     * when there is no such key. Returns false if a full seek is needed.
+     */
+    bool trySeekFromCurrentPosition(StringData query) {
+        const int maxSteps = gWiredTigerIndexCursorSeekReuseMaxSteps.load();
+        if (maxSteps <= 0 || !_cursor || _eof || _lastMoveSkippedKey || _kvView.isEmpty() ||
+            _endPositionChangedSinceSeek) {
+            return false;
+        }
+
+        // The underlying cursor is only still positioned, and the bounds only still apply, within
+        // the snapshot the last seek was done in. Writes in our own unit of work could also add
+        // keys behind the current position that a fresh search would find.
+        auto& ru = *shard_role_details::getRecoveryUnit(_opCtx);
+        if (ru.inUnitOfWork() || ru.getSnapshotId() != _lastSeekSnapshotId) {
+            return false;
+        }
+
+        auto current = _kvView.getKeyStringOriginalView();
+        int cmp = lexCompare(query.data(), query.size(), current.data(), current.size());
+        if (_forward ? cmp <= 0 : cmp >= 0) {
+            // The query does not pass the current key. The cursor has not moved since the last
+            // seek and that seek skipped every key between its search key and the current key,
+            // so the current key is the answer as long as the query does not precede that search
+            // key.
+            if (!_positionedBySeek) {
+                return false;
+            }
+            int seekCmp = lexCompare(
+                query.data(), query.size(), _lastSeekKey.getBuffer(), _lastSeekKey.getSize());
+            return _forward ? seekCmp >= 0 : seekCmp <= 0;
+        }
+
+        // The query is past the current key. Every key between the current key and the next one
+        // is invisible to us, so stepping forward lands on the same key a fresh seek would. Only
+        // that key is charged to the operation's metrics, as it would be for a fresh seek, so the
+        // keys stepped over and steps abandoned for a full seek are not counted as reads.
+        for (int step = 0; step < maxSteps; ++step) {
+            if (!advanceWTCursor()) {
+                _eof = true;
+                _id = RecordId();
+                _kvView.reset();
+                return true;
+            }
+
+            WT_CURSOR* c = _cursor->get();
+            WT_ITEM item;
+            WT_ITEM value;
+            getKeyValue(c, &item, &value, nullptr /* metrics */);
+            updatePosition(static_cast<const char*>(item.data),
+                           item.size,
+                           static_cast<const char*>(value.data),
+                           value.size);
+
+            cmp = lexCompare(query.data(), query.size(), item.data, item.size);
+            if (_forward ? cmp <= 0 : cmp >= 0) {
+                if (_metrics) {
+                    _metrics->incrementOneIdxEntryRead(c->internal_uri, item.size);
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     // Returns false on EOF and when true, positions the cursor on a key greater than or equal to
     // searchKey, direction dependent.
     [[nodiscard]] bool seekWTCursorInternal(const WiredTigerItem& searchKey) {
@@ -1200,14 +1278,27 @@ protected:
 
 
     void seekForKeyStringInternal(StringData keyString) {
+        if (trySeekFromCurrentPosition(keyString)) {
+            _lastSeekKey.resetFromBuffer(keyString.data(), keyString.size());
+            _positionedBySeek = true;
+            return;
+        }
+
         _eof = !seekWTCursor(keyString);
 
         _lastMoveSkippedKey = false;
+        _positionedBySeek = false;
         _id = RecordId();
 
         if (_eof)
             return;
 
+        if (gWiredTigerIndexCursorSeekReuseMaxSteps.load() > 0) {
+            _lastSeekKey.resetFromBuffer(keyString.data(), keyString.size());
+            _lastSeekSnapshotId = shard_role_details::getRecoveryUnit(_opCtx)->getSnapshotId();
+            _positionedBySeek = true;
+        }
+
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
         WT_ITEM value;
@@ -1237,6 +1328,7 @@ protected:
             _eof = !advanceWTCursor();
 
         _lastMoveSkippedKey = false;
+        _positionedBySeek = false;
 
         if (_eof) {
             // In the normal case, _id will be updated in updatePosition. Making this reset
@@ -1297,6 +1389,13 @@ protected:
 
     std::unique_ptr<key_string::Value> _endPosition;
 
+    // State of the last seek, used by trySeekFromCurrentPosition() to avoid searching the tree
+    // again. '_positionedBySeek' is true until the cursor moves by any means other than a seek.
+    key_string::Builder _lastSeekKey;
+    SnapshotId _lastSeekSnapshotId;
+    bool _positionedBySeek = false;
+    bool _endPositionChangedSinceSeek = false;
+
     // Used by next to decide to return current position rather than moving. Should be reset to
     // false by any operation that moves the cursor, other than subsequent save/restore pairs.
     bool _lastMoveSkippedKey = false;
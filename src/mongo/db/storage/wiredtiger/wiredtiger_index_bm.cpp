@@ -27,11 +27,85 @@
  *    it in the license file.
  */
 
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/key_string/key_string.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/db/storage/sorted_data_interface_test_assert.h"
+#include "mongo/db/storage/sorted_data_interface_test_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/unittest/assert.h"
 
 namespace mongo {
 namespace {
 
-// No WT-specific index benchmarks for now. Still need a source file to produce a benchmark.
+/**
+ * Equality lookups on the leading field of a compound index {a: 1, b: 1}, issued in ascending order
+ * on one cursor like an index nested loop join or a large $in would. Each group of 'a' values has
+ * 'entriesPerGroup' entries, and consecutive lookups are 'stride' groups apart. The benchmark is
+ * run with and without reusing the cursor position for seeks.
+ */
+void BM_WTIndexAscendingPrefixSeeks(benchmark::State& state, bool reusePosition) {
+    const int numGroups = 10'000;
+    const int entriesPerGroup = state.range(0);
+    const int stride = state.range(1);
+
+    auto harness = newSortedDataInterfaceHarnessHelper();
+    auto opCtx = harness->newOperationContext();
+    auto sorted = harness->newSortedDataInterface(opCtx.get(), /*unique=*/false, /*partial=*/false);
+
+    {
+        StorageWriteTransaction txn(*shard_role_details::getRecoveryUnit(opCtx.get()));
+        for (int a = 0; a < numGroups; ++a) {
+            for (int b = 0; b < entriesPerGroup; ++b) {
+                RecordId loc(a * entriesPerGroup + b + 1);
+                ASSERT_SDI_INSERT_OK(sorted->insert(
+                    opCtx.get(), makeKeyString(sorted.get(), BSON("" << a << "" << b), loc), true));
+            }
+        }
+        txn.commit();
+    }
+
+    std::vector<key_string::Value> probes;
+    for (int a = 0; a < numGroups; a += stride) {
+        probes.push_back(
+            makeKeyStringForSeek(sorted.get(), BSON("" << a), true, true).getValueCopy());
+    }
+
+    const auto originalMaxSteps = gWiredTigerIndexCursorSeekReuseMaxSteps.load();
+    gWiredTigerIndexCursorSeekReuseMaxSteps.store(reusePosition ? originalMaxSteps : 0);
+
+    auto cursor = sorted->newCursor(opCtx.get());
+    size_t itemsProcessed = 0;
+    for (auto _ : state) {
+        for (auto&& probe : probes) {
+            benchmark::DoNotOptimize(cursor->seek(StringData(probe.getBuffer(), probe.getSize())));
+        }
+        itemsProcessed += probes.size();
+        cursor->save();
+        cursor->restore();
+    }
+    state.SetItemsProcessed(itemsProcessed);
+
+    gWiredTigerIndexCursorSeekReuseMaxSteps.store(originalMaxSteps);
+}
+
+BENCHMARK_CAPTURE(BM_WTIndexAscendingPrefixSeeks, ReusePosition, true)
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->Args({1, 64})
+    ->Args({16, 1});
+BENCHMARK_CAPTURE(BM_WTIndexAscendingPrefixSeeks, AlwaysSearch, false)
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->Args({1, 64})
+    ->Args({16, 1});
 
 }  // namespace
 }  // namespace mongo
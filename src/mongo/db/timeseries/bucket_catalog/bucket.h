@@ -107,7 +107,7 @@ public:
     // incoming measurements.
     bool crossedLargeMeasurementThreshold = false;
 
-    // True if the bucket already exists and was reopened.
+    // True if the bucket already exists and was reopened, until the first batch is committed to it.
     bool isReopened = false;
 
     // Whether the bucket was created while the always used compressed buckets feature flag was
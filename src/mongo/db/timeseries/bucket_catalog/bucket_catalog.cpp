@@ -605,6 +605,10 @@ boost::optional<ClosedBucket> finish(
         }
         bucket->measurementMap = std::move(batch->measurementMap);
         bucket->preparedBatch.reset();
+
+        // The first commit after reopening has checked the builders rebuilt from the on-disk
+        // binary. Later batches append to the same builders and don't need to be checked again.
+        bucket->isReopened = false;
     }
 
     auto& stats = batch->stats;
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <variant>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/timeseries/bucket_catalog/bucket_catalog.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo::timeseries::bucket_catalog {
+namespace {
+
+static constexpr uint64_t kStorageCacheSizeBytes = 1024 * 1024 * 1024;
+static constexpr int kSeriesPerThread = 16;
+
+/**
+ * Inserts measurements from several threads at once and commits each batch right away, the way an
+ * insert command does when nothing else is writing to the same bucket. Every thread writes to its
+ * own set of series so the only shared state is the catalog itself; the argument is the number of
+ * stripes, which shows how much of the per-insert cost is contention on the stripe mutexes.
+ */
+void BM_ConcurrentInsertAndCommit(benchmark::State& state) {
+    static std::unique_ptr<BucketCatalog> catalog;
+    static UUID collectionUUID = UUID::gen();
+    if (state.thread_index == 0) {
+        catalog = std::make_unique<BucketCatalog>(state.range(0), [] { return UINT64_MAX; });
+    }
+
+    TimeseriesOptions options;
+    options.setTimeField("t");
+    options.setMetaField(StringData{"m"});
+
+    Date_t time = Date_t::now();
+    long long measurement = 0;
+    for (auto _ : state) {
+        auto series = state.thread_index * kSeriesPerThread + measurement % kSeriesPerThread;
+        auto doc = BSON("t" << time << "m" << series << "value" << measurement);
+        if (++measurement % kSeriesPerThread == 0) {
+            time += Milliseconds{1};
+        }
+
+        auto [insertContext, measurementTime] = uassertStatusOK(
+            prepareInsert(*catalog, collectionUUID, nullptr, options, doc));
+        auto result = uassertStatusOK(insert(*catalog,
+                                             nullptr,
+                                             doc,
+                                             state.thread_index + 1,
+                                             CombineWithInsertsFromOtherClients::kAllow,
+                                             insertContext,
+                                             measurementTime,
+                                             kStorageCacheSizeBytes));
+        auto& batch = get<SuccessfulInsertion>(result).batch;
+        if (claimWriteBatchCommitRights(*batch)) {
+            uassertStatusOK(prepareCommit(*catalog, batch, nullptr));
+            finish(*catalog, batch, {});
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        catalog.reset();
+    }
+}
+
+BENCHMARK(BM_ConcurrentInsertAndCommit)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores())
+    ->ArgName("stripes")
+    ->Arg(1)
+    ->Arg(32)
+    ->Arg(256)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo::timeseries::bucket_catalog
@@ -2145,12 +2145,29 @@ TEST_F(BucketCatalogTest, InsertIntoReopenedUncompressedBucket) {
     ASSERT(claimWriteBatchCommitRights(*batch));
     ASSERT_OK(prepareCommit(*_bucketCatalog, batch, _getCollator(_ns1)));
     ASSERT_EQ(batch->measurements.size(), 1);
+    ASSERT_TRUE(batch->isReopened);
     finish(*_bucketCatalog, batch, {});
     // Verify the old bucket was soft-closed
     ASSERT_EQ(1, _getExecutionStat(_uuid1, kNumClosedDueToReopening));
     ASSERT_EQ(1, _getExecutionStat(_uuid1, kNumBucketsReopened));
     ASSERT_FALSE(get<SuccessfulInsertion>(result.getValue()).closedBuckets.empty());
 
+    // Only the first batch committed to the reopened bucket is flagged as reopened.
+    auto appendResult =
+        _insertOneHelper(_opCtx,
+                         *_bucketCatalog,
+                         _ns1,
+                         _uuid1,
+                         ::mongo::fromjson(R"({"time":{"$date":"2022-06-06T15:35:50.000Z"}})"));
+    ASSERT_OK(appendResult.getStatus());
+    auto appendBatch = get<SuccessfulInsertion>(appendResult.getValue()).batch;
+    ASSERT_EQ(appendBatch->bucketId.oid, bucketDoc["_id"].OID());
+    ASSERT(claimWriteBatchCommitRights(*appendBatch));
+    ASSERT_OK(prepareCommit(*_bucketCatalog, appendBatch, _getCollator(_ns1)));
+    ASSERT_EQ(appendBatch->numPreviouslyCommittedMeasurements, 2);
+    ASSERT_FALSE(appendBatch->isReopened);
+    finish(*_bucketCatalog, appendBatch, {});
+
     // Verify that if we try another insert for the soft-closed bucket, we get a query-based
     // reopening candidate.
     auto doc3 = ::mongo::fromjson(R"({"time":{"$date":"2022-06-05T15:35:40.000Z"}})");
@@ -27,14 +27,31 @@
  *    it in the license file.
  */
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 
 #include "mongo/db/timeseries/bucket_catalog/global_bucket_catalog.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+#include "mongo/util/processinfo.h"
 
 namespace mongo::timeseries::bucket_catalog {
 namespace {
 const auto getGlobalBucketCatalog = ServiceContext::declareDecoration<GlobalBucketCatalog>();
-static constexpr std::size_t kNumStripes = 32;
+static constexpr std::size_t kMinNumStripes = 32;
+static constexpr std::size_t kMaxNumStripes = std::numeric_limits<StripeNumber>::max() + 1;
+
+/**
+ * Uses the configured stripe count if there is one, otherwise two stripes per available core so
+ * that concurrent inserts into different series rarely serialize on the same stripe mutex.
+ */
+std::size_t getNumStripes() {
+    if (gTimeseriesBucketCatalogStripes > 0) {
+        return gTimeseriesBucketCatalogStripes;
+    }
+    return std::clamp<std::size_t>(
+        2 * ProcessInfo::getNumAvailableCores(), kMinNumStripes, kMaxNumStripes);
+}
 }  // namespace
 
 GlobalBucketCatalog& GlobalBucketCatalog::get(ServiceContext* svcCtx) {
@@ -42,6 +59,6 @@ GlobalBucketCatalog& GlobalBucketCatalog::get(ServiceContext* svcCtx) {
 }
 
 GlobalBucketCatalog::GlobalBucketCatalog()
-    : BucketCatalog(kNumStripes, getTimeseriesIdleBucketExpiryMemoryUsageThresholdBytes) {}
+    : BucketCatalog(getNumStripes(), getTimeseriesIdleBucketExpiryMemoryUsageThresholdBytes) {}
 
 }  // namespace mongo::timeseries::bucket_catalog
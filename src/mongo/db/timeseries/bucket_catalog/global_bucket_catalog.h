@@ -35,7 +35,8 @@
 namespace mongo::timeseries::bucket_catalog {
 
 /**
- * The global bucket catalog with a fixed number of stripes, decorated on the service context.
+ * The global bucket catalog, decorated on the service context. The number of stripes is fixed at
+ * startup, either by the timeseriesBucketCatalogStripes parameter or from the number of cores.
  */
 class GlobalBucketCatalog : public BucketCatalog {
 public:
@@ -103,7 +103,8 @@ struct WriteBatch {
 
     bool generateCompressedDiff = false;
 
-    // True if the bucket already exists and was reopened.
+    // True if the bucket already exists and was reopened, and this is the first batch committed to
+    // it since.
     bool isReopened = false;
 
     // Whether the measurements in the bucket are sorted by timestamp or not.
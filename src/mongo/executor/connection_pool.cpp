@@ -302,9 +302,11 @@ public:
     void updateState(WithLock);
 
     /**
-     * Gets a connection from the specific pool.
+     * Gets a connection from the specific pool. `requestedAt` is when the caller asked for the
+     * connection. If an idle connection is handed out right away, its wait time is recorded here.
      */
     Future<ConnectionHandle> getConnection(WithLock,
+                                           Date_t requestedAt,
                                            Milliseconds timeout,
                                            bool lease,
                                            const CancellationToken& token);
@@ -771,10 +773,12 @@ SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::_get(const HostAndP
         timeout = _controller->pendingTimeout();
     }
 
-    auto connFuture = pool->getConnection(lk, timeout, lease, token);
+    auto connFuture = pool->getConnection(lk, connRequestedAt, timeout, lease, token);
     pool->updateState(lk);
 
-    if (lease) {
+    // A ready future was served from the idle connections, and its wait time is already recorded.
+    // Only requests that have to wait take the mutex again once they are fulfilled.
+    if (lease || connFuture.isReady()) {
         return std::move(connFuture).semi();
     }
 
@@ -892,16 +896,21 @@ size_t ConnectionPool::SpecificPool::requestsPending(WithLock) const {
 }
 
 Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnection(
-    WithLock lk, Milliseconds timeout, bool lease, const CancellationToken& token) {
+    WithLock lk,
+    Date_t requestedAt,
+    Milliseconds timeout,
+    bool lease,
+    const CancellationToken& token) {
 
     if (MONGO_unlikely(connectionPoolReturnsErrorOnGet.shouldFail())) {
         return Future<ConnectionPool::ConnectionHandle>::makeReady(
             Status(ErrorCodes::SocketException, "test"));
     }
 
-    // Reset our activity timestamp
-    auto now = _parent->_factory->now();
-    _lastActiveTime = now;
+    // Reset our activity timestamp. The caller read the clock before taking the mutex, so a
+    // concurrent caller may already have stored a later time.
+    auto now = requestedAt;
+    _lastActiveTime = std::max(_lastActiveTime, now);
 
     if (auto sfp = forceExecutorConnectionPoolTimeout.scoped(); MONGO_unlikely(sfp.isActive())) {
         const Milliseconds failpointTimeout{sfp.getData()["timeout"].numberInt()};
@@ -944,6 +953,9 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
                         kDiagnosticLogLevel,
                         "Using existing idle connection",
                         "hostAndPort"_attr = _hostAndPort);
+            if (!lease) {
+                recordConnectionWaitTime(lk, requestedAt);
+            }
             return Future<ConnectionPool::ConnectionHandle>::makeReady(std::move(conn));
         }
     }
@@ -987,15 +999,19 @@ auto ConnectionPool::SpecificPool::makeHandle(ConnectionInterface* connection, b
     auto connUseStartedAt = _parent->_getFastClockSource()->now();
     auto deleter = [this, anchor = shared_from_this(), connUseStartedAt, isLeased](
                        ConnectionInterface* connection) {
+        // Read the clocks before taking the pool-wide mutex to keep the critical section short.
+        const auto connUseEndedAt = _parent->_getFastClockSource()->now();
+        const auto returnedAt = _parent->_factory->now();
+
         stdx::unique_lock lk(_parent->_mutex);
 
         // Leased connections don't count towards the pool's total connection usage time.
         if (!isLeased) {
-            _totalConnUsageTime += _parent->_getFastClockSource()->now() - connUseStartedAt;
+            _totalConnUsageTime += connUseEndedAt - connUseStartedAt;
         }
 
         returnConnection(lk, connection, isLeased);
-        _lastActiveTime = _parent->_factory->now();
+        _lastActiveTime = std::max(_lastActiveTime, returnedAt);
         updateState(lk);
     };
     return ConnectionHandle(connection, std::move(deleter));
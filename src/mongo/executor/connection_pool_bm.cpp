@@ -0,0 +1,201 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/executor/connection_pool.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/out_of_line_executor.h"
+#include "mongo/util/system_clock_source.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo::executor {
+namespace {
+
+/** Timers never fire; the benchmark only exercises checkout and return of ready connections. */
+class BenchmarkTimer final : public ConnectionPool::TimerInterface {
+public:
+    void setTimeout(Milliseconds, TimeoutCallback) override {}
+    void cancelTimeout() override {}
+    Date_t now() override {
+        return Date_t::now();
+    }
+};
+
+/**
+ * A connection that does no I/O. Setup and refresh succeed, and their callbacks run on the
+ * executor, because the pool calls setup() and refresh() while holding its mutex.
+ */
+class BenchmarkConnection final : public ConnectionPool::ConnectionInterface {
+public:
+    BenchmarkConnection(HostAndPort host,
+                        size_t generation,
+                        std::shared_ptr<OutOfLineExecutor> executor)
+        : ConnectionInterface(generation), _host(std::move(host)), _executor(std::move(executor)) {}
+
+    const HostAndPort& getHostAndPort() const override {
+        return _host;
+    }
+
+    transport::ConnectSSLMode getSslMode() const override {
+        return transport::kGlobalSSLMode;
+    }
+
+    bool isHealthy() override {
+        return true;
+    }
+
+    void setTimeout(Milliseconds, TimeoutCallback) override {}
+    void cancelTimeout() override {}
+
+    Date_t now() override {
+        return Date_t::now();
+    }
+
+private:
+    void setup(Milliseconds, SetupCallback cb, std::string) override {
+        _succeedOnExecutor(std::move(cb));
+    }
+
+    void refresh(Milliseconds, RefreshCallback cb) override {
+        _succeedOnExecutor(std::move(cb));
+    }
+
+    template <typename Callback>
+    void _succeedOnExecutor(Callback cb) {
+        _executor->schedule(
+            [this, cb = std::move(cb)](Status) mutable { cb(this, Status::OK()); });
+    }
+
+    HostAndPort _host;
+    std::shared_ptr<OutOfLineExecutor> _executor;
+};
+
+class BenchmarkFactory final : public ConnectionPool::DependentTypeFactoryInterface {
+public:
+    BenchmarkFactory() : _executor(_makeExecutor()) {
+        _executor->startup();
+    }
+
+    std::shared_ptr<ConnectionPool::ConnectionInterface> makeConnection(
+        const HostAndPort& host, transport::ConnectSSLMode, size_t generation) override {
+        return std::make_shared<BenchmarkConnection>(host, generation, getExecutor());
+    }
+
+    std::shared_ptr<ConnectionPool::TimerInterface> makeTimer() override {
+        return std::make_shared<BenchmarkTimer>();
+    }
+
+    const std::shared_ptr<OutOfLineExecutor>& getExecutor() override {
+        return _outOfLineExecutor;
+    }
+
+    Date_t now() override {
+        return Date_t::now();
+    }
+
+    ClockSource* getFastClockSource() override {
+        return SystemClockSource::get();
+    }
+
+    // Called by the pool with its mutex held, so the executor is joined separately.
+    void shutdown() override {}
+
+    void join() {
+        _executor->shutdown();
+        _executor->join();
+    }
+
+private:
+    static std::shared_ptr<ThreadPool> _makeExecutor() {
+        ThreadPool::Options options;
+        options.poolName = "ConnectionPoolBM";
+        options.minThreads = 1;
+        options.maxThreads = 4;
+        return std::make_shared<ThreadPool>(std::move(options));
+    }
+
+    std::shared_ptr<ThreadPool> _executor;
+    std::shared_ptr<OutOfLineExecutor> _outOfLineExecutor = _executor;
+};
+
+std::shared_ptr<BenchmarkFactory> factory;
+std::shared_ptr<ConnectionPool> pool;
+std::vector<HostAndPort> hosts;
+
+/**
+ * Mirrors a scatter-gather on a router: every iteration checks out one connection to each of
+ * `state.range(0)` hosts and returns it, from as many threads as the benchmark runs. After warm
+ * up, all checkouts are served from idle connections, so this measures contention on the pool.
+ */
+void BM_getAndReturnReadyConnection(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        factory = std::make_shared<BenchmarkFactory>();
+        pool = std::make_shared<ConnectionPool>(factory, "ConnectionPoolBM");
+        hosts.clear();
+        for (int i = 0; i < state.range(0); ++i) {
+            hosts.emplace_back(fmt::format("shard{}.example.net", i), 27017);
+        }
+    }
+
+    for (auto _ : state) {
+        for (const auto& host : hosts) {
+            auto conn = pool->get(host, transport::kGlobalSSLMode, Seconds(30)).get();
+            conn->indicateUsed();
+            conn->indicateSuccess();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    if (state.thread_index == 0) {
+        pool->shutdown();
+        factory->join();
+        pool.reset();
+        factory.reset();
+    }
+}
+
+BENCHMARK(BM_getAndReturnReadyConnection)
+    ->Arg(1)
+    ->Arg(100)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo::executor
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <boost/cstdint.hpp>
 #include <cstdint>
+#include <map>
 #include <mutex>
 #include <string>
 
@@ -53,6 +54,7 @@
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/metadata.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/exec/async_results_merger.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -140,13 +142,17 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // support a default value for an enum. The default tailable mode should be 'kNormal', but
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(_params.getTailableMode().value_or(TailableModeEnum::kNormal)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeTree(_remotes,
+                 MergingComparator(_remotes,
+                                   _params.getSort().value_or(BSONObj()),
+                                   _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (_params.getTxnNumber()) {
         invariant(_params.getSessionId());
     }
 
+    _mergeTree.reset(_params.getRemotes().size());
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params.getRemotes()) {
         _remotes.emplace_back(remote.getHostAndPort(),
@@ -248,6 +254,9 @@ void AsyncResultsMerger::detachFromOperationContext() {
     _processAdditionalTransactionParticipants(_opCtx);
 
     _opCtx = nullptr;
+    // A caller that detaches has stopped waiting, for example after an awaitData timeout. The time
+    // until its next getMore is the client's, not a remote's stall.
+    _waitingSince = boost::none;
     // If we were about ready to return a boost::none because a tailable cursor reached the end of
     // the batch, that should no longer apply to the next use - when we are reattached to a
     // different OperationContext, it signals that the caller is ready for a new batch, and wants us
@@ -296,6 +305,24 @@ std::size_t AsyncResultsMerger::getNumRemotes() const {
     });
 }
 
+BSONObj AsyncResultsMerger::getRemoteStallTimes() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // A shard may own more than one of the remote cursors, so sum the stalls per shard.
+    std::map<ShardId, Milliseconds> stallTimes;
+    for (const auto& remote : _remotes) {
+        if (remote.stallTime > Milliseconds(0) && remote.shardId.isValid()) {
+            stallTimes[remote.shardId] += remote.stallTime;
+        }
+    }
+
+    BSONObjBuilder bob;
+    for (const auto& [shardId, stallTime] : stallTimes) {
+        bob.append(shardId.toString(), durationCount<Milliseconds>(stallTime));
+    }
+    return bob.obj();
+}
+
 BSONObj AsyncResultsMerger::getHighWaterMark() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     // At this point, the high water mark may be the resume token of the last document we returned.
@@ -359,12 +386,12 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    auto smallestRemote = _mergeTree.top();
+    const auto& smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
@@ -408,7 +435,14 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
         return {ClusterQueryResult()};
     }
 
-    return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    auto result = _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    if (auto readAheadStatus = _scheduleReadAheads(lk); !readAheadStatus.isOK()) {
+        LOGV2_DEBUG(10745811,
+                    2,
+                    "Failed to schedule read-ahead getMores; they will be sent when needed",
+                    "error"_attr = readAheadStatus);
+    }
+    return result;
 }
 
 void AsyncResultsMerger::_processAdditionalTransactionParticipants(OperationContext* opCtx) {
@@ -421,28 +455,23 @@ void AsyncResultsMerger::_processAdditionalTransactionParticipants(OperationCont
     }
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree.top();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status);
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    ClusterQueryResult front = _takeNextResult(lk, smallestRemote);
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
-    }
+    // Let the next result from 'smallestRemote', if it has one, compete for the top of the tree.
+    _mergeTree.replayWinner();
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -455,15 +484,14 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
         invariant(_remotes[_gettingFromRemote].status);
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
-            _remotes[_gettingFromRemote].docBuffer.pop();
+            ClusterQueryResult front = _takeNextResult(lk, _gettingFromRemote);
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -486,6 +514,18 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
+ClusterQueryResult AsyncResultsMerger::_takeNextResult(WithLock, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    ClusterQueryResult front = std::move(remote.docBuffer.front());
+    remote.docBuffer.pop();
+
+    const auto objSize = front.getResult()->objsize();
+    remote.bufferedBytes -= objSize;
+    _bufferedBytes -= objSize;
+    ++remote.consumedSinceBatch;
+    return front;
+}
+
 BSONObj AsyncResultsMerger::_makeRequest(WithLock,
                                          size_t remoteIndex,
                                          const ServerGlobalParams::FCVSnapshot& fcvSnapshot) {
@@ -560,11 +600,9 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
         return interruptStatus;
     }
 
-    const auto fcvSnapshot = serverGlobalParams.featureCompatibility.acquireFCVSnapshot();
-
     // Schedule remote work on hosts for which we need more results.
+    const auto now = _executor->now();
     std::vector<size_t> remoteIdxs;
-    std::vector<AsyncRequestsSender::Request> asyncRequests;
     for (size_t i = 0; i < _remotes.size(); ++i) {
         auto& remote = _remotes[i];
 
@@ -573,15 +611,26 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
             return remote.status;
         }
 
-        if (!remote.hasNext() && !remote.exhausted() && !remote.cbHandle.isValid()) {
+        if (!remote.exhausted() && !remote.cbHandle.isValid() &&
+            (!remote.hasNext() || _shouldReadAhead(lk, remote, now))) {
             // If this remote is not exhausted and there is no outstanding request for it, schedule
-            // work to retrieve the next batch.
-            auto req = _makeRequest(lk, i, fcvSnapshot);
+            // work to retrieve the next batch once its buffer is empty or about to run out.
             remoteIdxs.emplace_back(i);
-            asyncRequests.emplace_back(remote.shardId, std::move(req));
         }
     }
 
+    return _sendGetMores(lk, remoteIdxs);
+}
+
+Status AsyncResultsMerger::_sendGetMores(WithLock lk, const std::vector<size_t>& remoteIdxs) {
+    const auto fcvSnapshot = serverGlobalParams.featureCompatibility.acquireFCVSnapshot();
+
+    std::vector<AsyncRequestsSender::Request> asyncRequests;
+    for (auto remoteIndex : remoteIdxs) {
+        auto req = _makeRequest(lk, remoteIndex, fcvSnapshot);
+        asyncRequests.emplace_back(_remotes[remoteIndex].shardId, std::move(req));
+    }
+
     // Build the batch of requests to send if inside a transaction.
     std::vector<executor::RemoteCommandRequest> executorRequests;
     auto txnRequests = [&] {
@@ -602,6 +651,7 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
         const auto remoteIndex = remoteIdxs[i];
         auto& remote = _remotes[remoteIndex];
         auto& request = executorRequests[i];
+        remote.batchRequestedAt = _executor->now();
         auto callbackStatus =
             _executor->scheduleRemoteCommand(request, [this, remoteIndex](auto const& cbData) {
                 stdx::lock_guard<stdx::mutex> lk(this->_mutex);
@@ -618,6 +668,59 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
     return Status::OK();
 }
 
+bool AsyncResultsMerger::_shouldReadAhead(WithLock,
+                                          const RemoteCursorData& remote,
+                                          Date_t now) const {
+    const auto maxBufferedBytes = internalQueryAsyncResultsMergerReadAheadMaxBufferedBytes.load();
+    if (maxBufferedBytes <= 0 || _tailableMode != TailableModeEnum::kNormal ||
+        _bufferedBytes >= maxBufferedBytes) {
+        return false;
+    }
+
+    // Requests on a session, and in particular in a transaction, must reach the shards in the order
+    // the client issued them, so only ask for a batch once the merge actually needs it.
+    if (_params.getTxnNumber() || _params.getSessionId()) {
+        return false;
+    }
+
+    // Until a getMore to this remote has completed there is no round trip time to go by, so ask
+    // for the next batch once half of the current one has been consumed.
+    long long watermark = remote.lastBatchSize / 2;
+    if (remote.lastRoundTrip) {
+        // Otherwise keep enough results buffered to last one round trip at the rate this remote's
+        // results have been consumed since its last batch arrived.
+        const auto elapsed = std::max(now - remote.batchReceivedAt, Milliseconds(1));
+        watermark = std::min(remote.consumedSinceBatch *
+                                 durationCount<Milliseconds>(*remote.lastRoundTrip) /
+                                 durationCount<Milliseconds>(elapsed),
+                             remote.lastBatchSize);
+    }
+    return static_cast<long long>(remote.docBuffer.size()) <= watermark;
+}
+
+Status AsyncResultsMerger::_scheduleReadAheads(WithLock lk) {
+    if (internalQueryAsyncResultsMergerReadAheadMaxBufferedBytes.load() <= 0 ||
+        _lifecycleState != kAlive || !_opCtx || !_opCtx->checkForInterruptNoAssert().isOK()) {
+        return Status::OK();
+    }
+
+    const auto now = _executor->now();
+    std::vector<size_t> remoteIdxs;
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        const auto& remote = _remotes[i];
+        if (remote.status.isOK() && remote.hasNext() && !remote.exhausted() &&
+            !remote.cbHandle.isValid() && _shouldReadAhead(lk, remote, now)) {
+            remoteIdxs.emplace_back(i);
+        }
+    }
+
+    if (remoteIdxs.empty()) {
+        return Status::OK();
+    }
+    // A remote whose read-ahead could not be scheduled is asked again once its buffer is empty.
+    return _sendGetMores(lk, remoteIdxs);
+}
+
 /*
  * Note: When nextEvent() is called to do retries, only the remotes with retriable errors will
  * be rescheduled because:
@@ -647,6 +750,11 @@ StatusWith<executor::TaskExecutor::EventHandle> AsyncResultsMerger::nextEvent()
         return getMoresStatus;
     }
 
+    // The caller is about to wait. The wait is charged to the remote whose batch ends it.
+    if (!_waitingSince) {
+        _waitingSince = _executor->now();
+    }
+
     auto eventStatus = _executor->makeEvent();
     if (!eventStatus.isOK()) {
         return eventStatus;
@@ -818,6 +926,12 @@ void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
     } catch (DBException const& e) {
         _remotes[remoteIndex].status = e.toStatus();
     }
+    if (_waitingSince && _ready(lk)) {
+        // Other remotes may also have had batches in flight, but this is the one the merge was
+        // still waiting on.
+        remote.stallTime += _executor->now() - *_waitingSince;
+        _waitingSince = boost::none;
+    }
     _signalCurrentEventIfReady(lk);  // Wake up anyone waiting on '_currentEvent'.
 }
 
@@ -849,6 +963,11 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        _bufferedBytes -= remote.bufferedBytes;
+        remote.bufferedBytes = 0;
+        if (_params.getSort()) {
+            _mergeTree.invalidate(remoteIndex);
+        }
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -858,6 +977,7 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
                                               CbResponse const& response,
                                               size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
+
     if (!response.isOK()) {
         _cleanUpFailedBatch(lk, response.status, remoteIndex);
         return;
@@ -872,6 +992,9 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
         return;
     }
 
+    // Only a batch that actually arrived tells how long this remote takes to answer a getMore.
+    remote.lastRoundTrip = _executor->now() - remote.batchRequestedAt;
+
     CursorResponse cursorResponse = std::move(cursorResponseStatus.getValue());
     if (const auto& remoteMetrics = cursorResponse.getCursorMetrics()) {
         _metrics.aggregateCursorMetrics(*remoteMetrics);
@@ -902,6 +1025,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+    const bool hadNext = remote.hasNext();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -921,15 +1045,21 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
-        ClusterQueryResult result(obj, remote.shardId);
-        remote.docBuffer.push(result);
+        remote.docBuffer.emplace(obj, remote.shardId);
+        remote.bufferedBytes += obj.objsize();
+        _bufferedBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+    remote.lastBatchSize = response.getBatch().size();
+    remote.batchReceivedAt = _executor->now();
+    remote.consumedSinceBatch = 0;
+
+    // If we're doing a sorted merge and this remote had nothing buffered, its first result has
+    // changed and it has to be replayed in the merge tree. A batch fetched ahead is appended
+    // behind results the tree has already seen.
+    if (_params.getSort() && !hadNext && !response.getBatch().empty()) {
+        _mergeTree.invalidate(remoteIndex);
     }
     return true;
 }
@@ -942,6 +1072,8 @@ void AsyncResultsMerger::_signalCurrentEventIfReady(WithLock lk) {
         // invalid after signalling it.
         _executor->signalEvent(_currentEvent);
         _currentEvent = executor::TaskExecutor::EventHandle();
+        // The caller's wait is over; nextEvent() starts timing the next one.
+        _waitingSince = boost::none;
     }
 }
 
@@ -1098,6 +1230,89 @@ bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const
                            _sort) > 0;
 }
 
+//
+// AsyncResultsMerger::MergeTree
+//
+
+void AsyncResultsMerger::MergeTree::reset(size_t numRemotes) {
+    _numLeaves = numRemotes;
+    _nodes.assign(std::max(numRemotes, size_t{1}), 0);
+    _stale = true;
+}
+
+void AsyncResultsMerger::MergeTree::invalidate(size_t remoteIndex) {
+    if (remoteIndex >= _numLeaves) {
+        // Remotes can be added after the merge has started.
+        reset(remoteIndex + 1);
+    }
+    _stale = true;
+}
+
+void AsyncResultsMerger::MergeTree::replayWinner() {
+    if (_stale) {
+        return;
+    }
+
+    // Walk from the winner's leaf to the root, playing the new key against the loser stored at
+    // each level. Whichever of the two wins moves up.
+    auto winner = _nodes[0];
+    for (auto node = (_numLeaves + winner) / 2; node > 0; node /= 2) {
+        if (_beats(_nodes[node], winner)) {
+            std::swap(_nodes[node], winner);
+        }
+    }
+    _nodes[0] = winner;
+}
+
+bool AsyncResultsMerger::MergeTree::empty() {
+    if (_numLeaves == 0) {
+        return true;
+    }
+    return !_hasNext(top());
+}
+
+size_t AsyncResultsMerger::MergeTree::top() {
+    invariant(_numLeaves > 0);
+    _rebuildIfStale();
+    return _nodes[0];
+}
+
+bool AsyncResultsMerger::MergeTree::_hasNext(size_t remoteIndex) const {
+    return remoteIndex < _remotes.size() && _remotes[remoteIndex].hasNext();
+}
+
+bool AsyncResultsMerger::MergeTree::_beats(size_t lhs, size_t rhs) {
+    if (!_hasNext(lhs)) {
+        return false;
+    }
+    if (!_hasNext(rhs)) {
+        return true;
+    }
+    // The comparator orders remotes for a max-heap, so it reports whether 'rhs' sorts after 'lhs'.
+    // Equal keys are broken by remote index to keep the merge order deterministic.
+    return _comparator(rhs, lhs) || (!_comparator(lhs, rhs) && lhs < rhs);
+}
+
+size_t AsyncResultsMerger::MergeTree::_build(size_t node) {
+    if (node >= _numLeaves) {
+        return node - _numLeaves;
+    }
+    auto left = _build(2 * node);
+    auto right = _build(2 * node + 1);
+    if (_beats(right, left)) {
+        std::swap(left, right);
+    }
+    _nodes[node] = right;
+    return left;
+}
+
+void AsyncResultsMerger::MergeTree::_rebuildIfStale() {
+    if (_stale) {
+        _nodes[0] = _build(1);
+        _stale = false;
+    }
+}
+
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
     const MinSortKeyRemoteIdPair& lhs, const MinSortKeyRemoteIdPair& rhs) const {
     auto sortKeyComp = compareSortKeys(lhs.first, rhs.first, _sort);
@@ -243,6 +243,13 @@ public:
      */
     std::size_t getNumRemotes() const;
 
+    /**
+     * Returns, for each shard whose results have kept the merge waiting, the total time spent
+     * waiting for batches from that shard, as {<shardId>: <milliseconds>}. Each wait is charged to
+     * the one shard whose batch ended it; a wait still in progress is not included.
+     */
+    BSONObj getRemoteStallTimes() const;
+
     /**
      * For sorted tailable cursors, returns the most recent available sort key. This guarantees that
      * we will never return any future results which precede this key. If no results are ready to be
@@ -367,6 +374,24 @@ private:
 
         // If set to 'true', the cursor on this shard has been invalidated.
         bool invalidated = false;
+
+        // Total size in bytes of the results held in 'docBuffer'.
+        long long bufferedBytes = 0;
+
+        // The number of results in the most recently received batch, when that batch arrived, and
+        // how many results have been returned from this remote since. Used to size read-ahead.
+        long long lastBatchSize = 0;
+        Date_t batchReceivedAt;
+        long long consumedSinceBatch = 0;
+
+        // When the outstanding getMore to this remote was sent, and how long the previous getMore
+        // took to come back. The latter is not set until a getMore has completed.
+        Date_t batchRequestedAt;
+        boost::optional<Milliseconds> lastRoundTrip;
+
+        // Time the merge has spent waiting on a batch from this remote. A wait is charged to the
+        // remote whose batch made the merge ready again.
+        Milliseconds stallTime{0};
     };
 
     class MergingComparator {
@@ -389,6 +414,60 @@ private:
         const bool _compareWholeSortKey;
     };
 
+    /**
+     * A loser tree over the remotes, keyed on the sort key of the first result buffered for each
+     * remote. Remotes with nothing buffered lose to every other remote. Advancing the winner costs
+     * a single comparison per level of the tree, against two for popping and re-pushing a binary
+     * heap. Any other change to a remote's buffer marks the tree stale, and it is rebuilt the next
+     * time the winner is asked for.
+     */
+    class MergeTree {
+    public:
+        MergeTree(const std::vector<RemoteCursorData>& remotes, MergingComparator comparator)
+            : _remotes(remotes), _comparator(std::move(comparator)) {}
+
+        /**
+         * Sizes the tree for 'numRemotes' remotes. The tree is rebuilt on next use.
+         */
+        void reset(size_t numRemotes);
+
+        /**
+         * Notes that the first buffered result of 'remoteIndex', which need not be the current
+         * winner, has changed.
+         */
+        void invalidate(size_t remoteIndex);
+
+        /**
+         * Replays the matches of the current winner after its first buffered result has changed.
+         */
+        void replayWinner();
+
+        /**
+         * Returns true if no remote has a buffered result.
+         */
+        bool empty();
+
+        /**
+         * Returns the index of the remote whose first buffered result sorts first.
+         */
+        size_t top();
+
+    private:
+        bool _hasNext(size_t remoteIndex) const;
+        bool _beats(size_t lhs, size_t rhs);
+        size_t _build(size_t node);
+        void _rebuildIfStale();
+
+        const std::vector<RemoteCursorData>& _remotes;
+        MergingComparator _comparator;
+
+        // With n leaves, '_nodes[0]' is the overall winner and '_nodes[1..n-1]' hold the loser of
+        // the match played at each internal node. Leaf i sits at position n + i.
+        std::vector<size_t> _nodes;
+        size_t _numLeaves = 0;
+        bool _stale = true;
+    };
+
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
 
     class PromisedMinSortKeyComparator {
@@ -442,6 +521,11 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
+    /**
+     * Removes the first result from the buffer of the given remote and returns it.
+     */
+    ClusterQueryResult _takeNextResult(WithLock, size_t remoteIndex);
+
     using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using CbResponse = executor::TaskExecutor::ResponseStatus;
 
@@ -506,6 +590,26 @@ private:
      */
     Status _scheduleGetMores(WithLock);
 
+    /**
+     * Schedules a getMore on each of the given remotes.
+     */
+    Status _sendGetMores(WithLock, const std::vector<size_t>& remoteIdxs);
+
+    /**
+     * Returns true if the next batch should be requested from 'remote' although it still has
+     * results buffered. Read-ahead is enabled by the
+     * 'internalQueryAsyncResultsMergerReadAheadMaxBufferedBytes' knob, and never used for
+     * operations that run on a session.
+     */
+    bool _shouldReadAhead(WithLock, const RemoteCursorData& remote, Date_t now) const;
+
+    /**
+     * Schedules read-ahead getMores for remotes whose buffers are running low. Called after a
+     * result has been returned. Returns the error if a getMore could not be scheduled; the remote
+     * is then asked again by the next call to nextEvent(), which surfaces a persistent failure.
+     */
+    Status _scheduleReadAheads(WithLock);
+
     /**
      * Schedules a killCursors command to be run on all remote hosts that have open cursors.
      */
@@ -557,9 +661,15 @@ private:
     // List of pending responses to be processed for additional participants.
     std::queue<RemoteResponse> _remoteResponses;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The winner of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    MergeTree _mergeTree;
+
+    // Total size in bytes of the results buffered across all remotes.
+    long long _bufferedBytes = 0;
+
+    // When the caller started waiting for the merge to become ready, if it is waiting now.
+    boost::optional<Date_t> _waitingSince;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -320,6 +320,173 @@ TEST_F(AsyncResultsMergerTest, MultiShardSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, MultiShardSortedResultsCarryOriginatingShard) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [5]}"), fromjson("{$sortKey: [6]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [3]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // Results are moved out of the per-remote buffers as they are merged; each must still report
+    // the shard it came from.
+    auto result = unittest::assertGet(arm->nextReady());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [3]}"), *result.getResult());
+    ASSERT_EQ(kTestShardIds[1], *result.getShardId());
+    result = unittest::assertGet(arm->nextReady());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [5]}"), *result.getResult());
+    ASSERT_EQ(kTestShardIds[0], *result.getShardId());
+    result = unittest::assertGet(arm->nextReady());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [6]}"), *result.getResult());
+    ASSERT_EQ(kTestShardIds[0], *result.getShardId());
+
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, MultiShardSortedReadsAheadBeforeBufferRunsOut) {
+    RAIIServerParameterControllerForTest readAheadController(
+        "internalQueryAsyncResultsMergerReadAheadMaxBufferedBytes", 1024 * 1024);
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1]}"),
+                                   fromjson("{$sortKey: [3]}"),
+                                   fromjson("{$sortKey: [5]}"),
+                                   fromjson("{$sortKey: [7]}")};
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [2]}"),
+                                   fromjson("{$sortKey: [4]}"),
+                                   fromjson("{$sortKey: [6]}"),
+                                   fromjson("{$sortKey: [8]}")};
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // No getMore round trip has been observed yet, so a remote's next batch is requested once half
+    // of its current batch has been consumed.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [3]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(kTestShardHosts[0], getNthPendingRequest(0).target);
+    ASSERT_TRUE(arm->ready());
+
+    // The first shard's next batch lands behind the results it already has buffered.
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [9]}"), fromjson("{$sortKey: [11]}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch3));
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [4]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(kTestShardHosts[1], getNthPendingRequest(0).target);
+    std::vector<BSONObj> batch4 = {fromjson("{$sortKey: [10]}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch4));
+
+    // Every remaining result was fetched ahead, so the merge never has to wait.
+    for (int key = 5; key <= 11; ++key) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON_ARRAY(key)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+    ASSERT_FALSE(networkHasReadyRequests());
+}
+
+TEST_F(AsyncResultsMergerTest, ReportsTimeSpentWaitingOnEachShard) {
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+    ASSERT_BSONOBJ_EQ(BSONObj(), arm->getRemoteStallTimes());
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        guard->advanceTime(guard->now() + Milliseconds(50));
+    }
+    std::vector<BSONObj> batch = {fromjson("{_id: 1}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_BSONOBJ_EQ(BSON(kTestShardIds[0].toString() << 50LL), arm->getRemoteStallTimes());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, ChargesWaitOnlyToTheShardThatEndedIt) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // The sorted merge needs a result from both shards. The first shard answers after 20ms, but the
+    // merge keeps waiting for the second one, which answers after 50ms.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    auto advanceTime = [&](Milliseconds by) {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        guard->advanceTime(guard->now() + by);
+    };
+    advanceTime(Milliseconds(20));
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), {fromjson("{$sortKey: [1]}")}));
+    ASSERT_FALSE(arm->ready());
+    advanceTime(Milliseconds(30));
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), {fromjson("{$sortKey: [2]}")}));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_BSONOBJ_EQ(BSON(kTestShardIds[1].toString() << 50LL), arm->getRemoteStallTimes());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, DoesNotChargeWaitAbandonedByTheCaller) {
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    // The caller gives up waiting and detaches, as an awaitData getMore does when it times out. The
+    // batch arrives while the client is between getMores.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    arm->detachFromOperationContext();
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        guard->advanceTime(guard->now() + Milliseconds(50));
+    }
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), {fromjson("{_id: 1}")}));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_BSONOBJ_EQ(BSONObj(), arm->getRemoteStallTimes());
+    arm->reattachToOperationContext(operationContext());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, MultiShardMultipleGets) {
     std::vector<RemoteCursor> cursors;
     cursors.push_back(
@@ -97,6 +97,10 @@ public:
         return _arm.getNumRemotes();
     }
 
+    BSONObj getRemoteStallTimes() const {
+        return _arm.getRemoteStallTimes();
+    }
+
     BSONObj getHighWaterMark() {
         return _arm.getHighWaterMark();
     }
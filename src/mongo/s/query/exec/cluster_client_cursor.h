@@ -130,6 +130,12 @@ public:
      */
     virtual std::size_t getNumRemotes() const = 0;
 
+    /**
+     * Returns, per shard, the time spent waiting for results from that shard, as
+     * {<shardId>: <milliseconds>}. Shards which have not held up the cursor are omitted.
+     */
+    virtual BSONObj getRemoteStallTimes() const = 0;
+
     /**
      * Returns the current most-recent resume token for this cursor, or an empty object if this is
      * not a $changeStream cursor.
@@ -138,7 +138,7 @@ StatusWith<ClusterQueryResult> ClusterClientCursorImpl::next() {
         auto front = std::move(_stash.front());
         _stash.pop();
         ++_numReturnedSoFar;
-        return {front};
+        return {std::move(front)};
     }
 
     auto next = _root->next();
@@ -205,6 +205,10 @@ std::size_t ClusterClientCursorImpl::getNumRemotes() const {
     return _root->getNumRemotes();
 }
 
+BSONObj ClusterClientCursorImpl::getRemoteStallTimes() const {
+    return _root->getRemoteStallTimes();
+}
+
 BSONObj ClusterClientCursorImpl::getPostBatchResumeToken() const {
     return _root->getPostBatchResumeToken();
 }
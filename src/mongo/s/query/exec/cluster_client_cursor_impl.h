@@ -106,6 +106,8 @@ public:
 
     std::size_t getNumRemotes() const final;
 
+    BSONObj getRemoteStallTimes() const final;
+
     BSONObj getPostBatchResumeToken() const final;
 
     long long getNumReturnedSoFar() const final;
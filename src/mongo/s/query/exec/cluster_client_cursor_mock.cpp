@@ -86,6 +86,10 @@ std::size_t ClusterClientCursorMock::getNumRemotes() const {
     MONGO_UNREACHABLE;
 }
 
+BSONObj ClusterClientCursorMock::getRemoteStallTimes() const {
+    return BSONObj();
+}
+
 BSONObj ClusterClientCursorMock::getPostBatchResumeToken() const {
     MONGO_UNREACHABLE;
 }
@@ -140,6 +140,9 @@ GenericCursor ClusterCursorManager::PinnedCursor::toGenericCursor() const {
     gc.setLastAccessDate(_cursor->getLastUseDate());
     gc.setCreatedDate(_cursor->getCreatedDate());
     gc.setNBatchesReturned(_cursor->getNBatches());
+    if (auto stallTimes = _cursor->getRemoteStallTimes(); !stallTimes.isEmpty()) {
+        gc.setRemoteStallMillis(std::move(stallTimes));
+    }
     return gc;
 }
 
@@ -506,6 +509,9 @@ GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
     gc.setOriginatingCommand(_cursor->getOriginatingCommand());
     gc.setNoCursorTimeout(getLifetimeType() == CursorLifetime::Immortal);
     gc.setNBatchesReturned(_cursor->getNBatches());
+    if (auto stallTimes = _cursor->getRemoteStallTimes(); !stallTimes.isEmpty()) {
+        gc.setRemoteStallMillis(std::move(stallTimes));
+    }
     return gc;
 }
 
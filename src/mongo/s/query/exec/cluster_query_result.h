@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include <boost/optional.hpp>
 
 #include "mongo/bson/bsonobj.h"
@@ -46,7 +48,7 @@ public:
     ClusterQueryResult() = default;
 
     ClusterQueryResult(BSONObj resObj, boost::optional<ShardId> shardId = boost::none)
-        : _resultObj(resObj), _shardId(shardId) {}
+        : _resultObj(std::move(resObj)), _shardId(std::move(shardId)) {}
 
     bool isEOF() const {
         return !_resultObj;
@@ -56,6 +58,14 @@ public:
         return _resultObj;
     }
 
+    /**
+     * Moves the result out of this object, leaving it EOF. Lets callers that consume a result
+     * exactly once avoid the reference count traffic of copying it.
+     */
+    boost::optional<BSONObj> releaseResult() {
+        return std::exchange(_resultObj, boost::none);
+    }
+
     boost::optional<ShardId> getShardId() const {
         return _shardId;
     }
@@ -101,6 +101,14 @@ public:
         return _child->getNumRemotes();
     }
 
+    /**
+     * Returns, per shard, the time this execution plan has spent waiting for results from that
+     * shard, as {<shardId>: <milliseconds>}. Shards which have not held up the plan are omitted.
+     */
+    virtual BSONObj getRemoteStallTimes() const {
+        return _child ? _child->getRemoteStallTimes() : BSONObj();
+    }
+
     /**
      * Returns whether or not all the remote cursors are exhausted.
      */
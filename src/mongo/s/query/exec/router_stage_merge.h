@@ -76,6 +76,10 @@ public:
         return _resultsMerger.getNumRemotes();
     }
 
+    BSONObj getRemoteStallTimes() const final {
+        return _resultsMerger.getRemoteStallTimes();
+    }
+
     BSONObj getPostBatchResumeToken() final {
         return _resultsMerger.getHighWaterMark();
     }
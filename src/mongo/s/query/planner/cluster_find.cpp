@@ -488,7 +488,7 @@ CursorId runQueryWithoutRetrying(OperationContext* opCtx,
             break;
         }
 
-        auto nextObj = *next.getResult();
+        auto nextObj = *next.releaseResult();
 
         // If adding this object will cause us to exceed the message size limit, then we stash it
         // for later.
@@ -1051,8 +1051,9 @@ StatusWith<CursorResponse> ClusterFind::runGetMore(OperationContext* opCtx,
             break;
         }
 
-        if (!responseSizeTracker.haveSpaceForNext(*next.getValue().getResult())) {
-            pinnedCursor.getValue()->queueResult(*next.getValue().getResult());
+        auto nextObj = *next.getValue().releaseResult();
+        if (!responseSizeTracker.haveSpaceForNext(nextObj)) {
+            pinnedCursor.getValue()->queueResult(nextObj);
             stashedResult = true;
             break;
         }
@@ -1061,8 +1062,8 @@ StatusWith<CursorResponse> ClusterFind::runGetMore(OperationContext* opCtx,
         awaitDataState(opCtx).shouldWaitForInserts = false;
 
         // Add doc to the batch.
-        responseSizeTracker.add(*next.getValue().getResult());
-        batch.push_back(std::move(*next.getValue().getResult()));
+        responseSizeTracker.add(nextObj);
+        batch.push_back(std::move(nextObj));
 
         // Update the postBatchResumeToken. For non-$changeStream aggregations, this will be empty.
         postBatchResumeToken = pinnedCursor.getValue()->getPostBatchResumeToken();
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <asio.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_options.h"
+#include "mongo/rpc/message.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/transport/asio/asio_transport_layer.h"
+#include "mongo/transport/session.h"
+#include "mongo/transport/test_fixtures.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo::transport {
+namespace {
+
+Message makePingMessage() {
+    OpMsgBuilder builder;
+    builder.setBody(BSON("ping" << 1));
+    Message msg = builder.finish();
+    msg.header().setResponseToMsgId(0);
+    msg.header().setId(0);
+    return msg;
+}
+
+/**
+ * Round trips small requests over a loopback connection to a sync ingress AsioSession, which
+ * sources each request and sinks it straight back as its reply. The first argument is how many
+ * requests the client pipelines in one write before reading the replies.
+ *
+ * The p50 and p99 counters are the latency of one such round, in microseconds. To get syscalls
+ * per request, run the benchmark under `strace -c -f` or `perf trace -s` and divide the server
+ * thread's recvfrom/sendmsg counts by the reported number of items.
+ */
+class AsioSessionBm : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        ServerGlobalParams params;
+        params.noUnixSocket = true;
+        params.bind_ips = {"127.0.0.1"};
+        AsioTransportLayer::Options opts(&params);
+        opts.port = 0;
+
+        auto sm = std::make_unique<test::MockSessionManager>([](test::SessionThread& st) {
+            st.schedule([](Session& session) {
+                while (true) {
+                    auto swMsg = session.sourceMessage();
+                    if (!swMsg.isOK() || !session.sinkMessage(swMsg.getValue()).isOK()) {
+                        return;
+                    }
+                }
+            });
+        });
+        _sessionManager = sm.get();
+        _tla = std::make_unique<AsioTransportLayer>(opts, std::move(sm));
+        invariant(_tla->setup());
+        invariant(_tla->start());
+
+        _client.connect(
+            asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), _tla->listenerPort()));
+        _client.set_option(asio::ip::tcp::no_delay(true));
+    }
+
+    void TearDown(benchmark::State& state) override {
+        // The session's loop ends once the client hangs up.
+        _client.close();
+        _sessionManager->endAllSessions({});
+        _tla->shutdown();
+        _tla.reset();
+    }
+
+    void run(benchmark::State& state) {
+        const auto pipelined = static_cast<size_t>(state.range(0));
+        const Message msg = makePingMessage();
+        std::string requests;
+        for (size_t i = 0; i < pipelined; ++i) {
+            requests.append(msg.buf(), msg.size());
+        }
+        std::string replies(requests.size(), '\0');
+
+        std::vector<double> latencies;
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            asio::write(_client, asio::buffer(requests));
+            asio::read(_client, asio::buffer(replies.data(), replies.size()));
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                    .count());
+        }
+        state.SetItemsProcessed(state.iterations() * pipelined);
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) {
+            return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+        };
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+    }
+
+private:
+    std::unique_ptr<AsioTransportLayer> _tla;
+    test::MockSessionManager* _sessionManager = nullptr;
+    asio::io_context _ioContext;
+    asio::ip::tcp::socket _client{_ioContext};
+};
+
+BENCHMARK_DEFINE_F(AsioSessionBm, RoundTrip)(benchmark::State& state) {
+    run(state);
+}
+
+BENCHMARK_REGISTER_F(AsioSessionBm, RoundTrip)->ArgName("Pipelined")->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
+}  // namespace mongo::transport
@@ -30,6 +30,9 @@
 
 #include "mongo/transport/asio/asio_session_impl.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/connection_health_metrics_parameter_gen.h"
@@ -113,6 +116,30 @@ Status makeCanceledStatus() {
     return {ErrorCodes::CallbackCanceled, "Operation was canceled"};
 }
 
+constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+/**
+ * Size of the per-thread buffer that sync-mode reads receive into. Large enough for the header and
+ * body of most requests, so those arrive with a single receive call.
+ */
+constexpr size_t kReadAheadSize = 16 * 1024;
+
+Status checkMessageLength(size_t msgLen) {
+    if (msgLen >= kHeaderSize && msgLen <= MaxMessageSizeBytes) {
+        return Status::OK();
+    }
+
+    StringBuilder sb;
+    sb << "recv(): message msgLen " << msgLen << " is invalid. "
+       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+    LOGV2(4615638,
+          "recv(): message mstLen is invalid.",
+          "msgLen"_attr = msgLen,
+          "min"_attr = kHeaderSize,
+          "max"_attr = MaxMessageSizeBytes);
+    return Status(ErrorCodes::ProtocolError, sb.str());
+}
+
 auto& totalIngressTLSConnections =  //
     *MetricBuilder<Counter64>("network.totalIngressTLSConnections");
 auto& totalIngressTLSHandshakeTimeMillis =  //
@@ -212,6 +239,9 @@ void CommonAsioSession::end() {
 
 StatusWith<Message> CommonAsioSession::sourceMessage() noexcept try {
     ensureSync();
+    if (canReadAhead()) {
+        return sourceMessageWithReadAhead();
+    }
     return sourceMessageImpl().getNoThrow();
 } catch (const DBException& ex) {
     return ex.toStatus();
@@ -226,6 +256,10 @@ Future<Message> CommonAsioSession::asyncSourceMessage(const BatonHandle& baton)
 
 Status CommonAsioSession::waitForData() noexcept try {
     ensureSync();
+    if (_pendingInputSize) {
+        // A previous read already pulled the start of the next message off the socket.
+        return Status::OK();
+    }
     asio::error_code ec;
     getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
     return errorCodeToStatus(ec, "waitForData");
@@ -414,6 +448,24 @@ void SyncAsioSession::ensureAsync() {
     invariant(false, "Attempted to use SyncAsioSession in async mode.");
 }
 
+Future<void> SyncAsioSession::asyncWaitForData() noexcept try {
+    ensureSync();
+    if (_pendingInputSize) {
+        return Future<void>::makeReady();
+    }
+#ifdef MONGO_CONFIG_SSL
+    // The SSL stream may already hold decrypted bytes that the raw socket no longer reports as
+    // readable, so waiting on the socket could park the session forever. Let the caller block in
+    // the read instead.
+    if (_sslSocket) {
+        return Future<void>::makeReady();
+    }
+#endif
+    return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
+} catch (const DBException& ex) {
+    return ex.toStatus();
+}
+
 auto CommonAsioSession::getSocket() -> GenericSocket& {
 #ifdef MONGO_CONFIG_SSL
     if (_sslSocket) {
@@ -467,8 +519,6 @@ ExecutorFuture<void> CommonAsioSession::parseProxyProtocolHeader(const ReactorHa
 }
 
 Future<Message> CommonAsioSession::sourceMessageImpl(const BatonHandle& baton) {
-    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
-
     auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
     auto ptr = headerBuffer.get();
     _asyncOpState.start();
@@ -479,18 +529,8 @@ Future<Message> CommonAsioSession::sourceMessageImpl(const BatonHandle& baton) {
             }
 
             const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                StringBuilder sb;
-                sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                const auto str = sb.str();
-                LOGV2(4615638,
-                      "recv(): message mstLen is invalid.",
-                      "msgLen"_attr = msgLen,
-                      "min"_attr = kHeaderSize,
-                      "max"_attr = MaxMessageSizeBytes);
-
-                return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+            if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+                return Future<Message>::makeReady(std::move(status));
             }
 
             if (msgLen == kHeaderSize) {
@@ -519,6 +559,78 @@ Future<Message> CommonAsioSession::sourceMessageImpl(const BatonHandle& baton) {
         });
 }
 
+bool CommonAsioSession::canReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+    // The first read of an ingress session decides whether the client is starting a TLS
+    // handshake, and TLS records must go through the SSL stream.
+    return _ranHandshake && !_sslSocket;
+#else
+    return true;
+#endif
+}
+
+StatusWith<Message> CommonAsioSession::sourceMessageWithReadAhead() {
+    thread_local const auto scratch = std::make_unique<char[]>(kReadAheadSize);
+
+    _asyncOpState.start();
+    ScopeGuard guard([&] { _asyncOpState.complete(); });
+
+    // Leftovers are at most one scratch buffer long, so they always fit back in.
+    size_t buffered = std::exchange(_pendingInputSize, 0);
+    if (buffered) {
+        memcpy(scratch.get(), _pendingInput.get(), buffered);
+        _pendingInput = {};
+    }
+
+    while (buffered < kHeaderSize) {
+        // Reads that opportunisticRead() would have done stop here too, so tests that hold reads
+        // with this failpoint keep covering sync sessions.
+        asioTransportLayerBlockBeforeOpportunisticRead.pauseWhileSet();
+
+        std::error_code ec;
+        size_t size;
+        do {
+            size = getSocket().read_some(
+                asio::buffer(scratch.get() + buffered, kReadAheadSize - buffered), ec);
+        } while (ec == asio::error::interrupted);  // retry syscall EINTR
+        if (ec) {
+            return errorCodeToStatus(ec, "sourceMessage");
+        }
+        buffered += size;
+    }
+
+    if (checkForHTTPRequest(asio::buffer(scratch.get(), kHeaderSize))) {
+        return sendHTTPResponse().getNoThrow();
+    }
+
+    const auto msgLen = size_t(MSGHEADER::View(scratch.get()).getMessageLength());
+    if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+        return status;
+    }
+
+    auto buffer = SharedBuffer::allocate(msgLen);
+    const auto fromScratch = std::min(buffered, msgLen);
+    memcpy(buffer.get(), scratch.get(), fromScratch);
+    if (fromScratch < msgLen) {
+        // Larger messages are read straight into their final buffer.
+        if (auto status =
+                read(asio::buffer(buffer.get() + fromScratch, msgLen - fromScratch)).getNoThrow();
+            !status.isOK()) {
+            return status;
+        }
+    } else if (buffered > msgLen) {
+        // The client pipelined more than one message; keep the rest for the next call.
+        _pendingInputSize = buffered - msgLen;
+        _pendingInput = SharedBuffer::allocate(_pendingInputSize);
+        memcpy(_pendingInput.get(), scratch.get() + msgLen, _pendingInputSize);
+    }
+
+    if (_isIngressSession) {
+        networkCounter.hitPhysicalIn(msgLen);
+    }
+    return Message(std::move(buffer));
+}
+
 template <typename MutableBufferSequence>
 Future<void> CommonAsioSession::read(const MutableBufferSequence& buffers,
                                      const BatonHandle& baton) {
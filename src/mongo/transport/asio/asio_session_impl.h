@@ -36,6 +36,7 @@
 #include "mongo/transport/asio/asio_session.h"
 #include "mongo/transport/asio/asio_transport_layer.h"
 #include "mongo/transport/baton.h"
+#include "mongo/util/shared_buffer.h"
 
 #ifdef MONGO_CONFIG_SSL
 #include "mongo/util/net/ssl.hpp"
@@ -183,6 +184,20 @@ protected:
     };
 
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr);
+
+    /**
+     * Whether sync-mode reads may use sourceMessageWithReadAhead(). This holds once the session
+     * knows that it is not speaking TLS.
+     */
+    bool canReadAhead() const;
+
+    /**
+     * Sync-mode message read for plaintext sockets. Instead of reading the header and the body
+     * separately, receives whatever the kernel has buffered into a per-thread scratch buffer, so a
+     * typical request costs a single receive call. Bytes past the end of the message belong to
+     * pipelined requests and are kept in `_pendingInput` for the next call.
+     */
+    StatusWith<Message> sourceMessageWithReadAhead();
     Future<void> sinkMessageImpl(Message message, const BatonHandle& baton = nullptr);
 
     template <typename MutableBufferSequence>
@@ -286,6 +301,11 @@ protected:
      */
     stdx::mutex _sslSocketLock{};
 
+    // Bytes already received for the next message. Only populated in sync mode, and only while
+    // the client has pipelined requests, so idle sessions do not hold on to a buffer.
+    SharedBuffer _pendingInput;
+    size_t _pendingInputSize = 0;
+
     AsioTransportLayer* const _tl;
     bool _isIngressSession;
     bool _isFromLoadBalancer = false;
@@ -336,7 +356,7 @@ protected:
 /**
  * This is an AsioSession which is intended to only use the `sourceMessage`, `sinkMessage`, and
  * `waitForData` subset of the Session's read/write/wait interface. Usage of async counterparts of
- * these functions causes an invariant to be triggered.
+ * these functions, other than `asyncWaitForData`, causes an invariant to be triggered.
  *
  * NOTE: See AsyncAsioSession's note explaining the current state and purpose of the separation.
  */
@@ -348,6 +368,15 @@ public:
         end();
     }
 
+    /**
+     * Waiting for readiness does not read from or write to the socket, so it is also allowed in
+     * sync mode. The wait completes on the reactor that owns the socket, which lets a service
+     * executor park the session between requests without dedicating a thread to it. TLS sessions
+     * are never parked, because decrypted data buffered in the SSL stream is not visible on the
+     * socket; for them the returned future is always ready.
+     */
+    Future<void> asyncWaitForData() noexcept override;
+
 protected:
     void ensureSync() override;
     void ensureAsync() override;
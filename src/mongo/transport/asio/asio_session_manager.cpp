@@ -29,9 +29,12 @@
 
 #include "mongo/transport/asio/asio_session_manager.h"
 
+#include <algorithm>
+
 #include "mongo/db/commands/server_status.h"
 #include "mongo/transport/hello_metrics.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_reserved.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_manager.h"
@@ -77,7 +80,10 @@ void AsioSessionManager::configureServiceExecutorContext(Client* client,
     // TODO SERVER-77921: use the return value of `Session::isFromRouterPort()` to choose an
     // instance of `ServiceEntryPoint`.
     auto seCtx = std::make_unique<ServiceExecutorContext>();
-    seCtx->setThreadModel(ServiceExecutorContext::kSynchronous);
+    // Clients share the pooled worker threads of ServiceExecutorFixed when it is configured.
+    seCtx->setThreadModel(ServiceExecutorFixed::get(_svcCtx)
+                              ? ServiceExecutorContext::kFixed
+                              : ServiceExecutorContext::kSynchronous);
     seCtx->setCanUseReserved(isPrivilegedSession);
     stdx::lock_guard lk(*client);
     ServiceExecutorContext::set(client, std::move(seCtx));
@@ -97,10 +103,13 @@ void AsioSessionManager::appendStats(BSONObjBuilder* bob) const {
 
     appendInt("active", getActiveOperations());
 
-    // Historically, this number may have differed from "current" since
-    // some sessions would have used the non-threaded ServiceExecutorFixed.
-    // Currently all sessions are threaded, so this number is redundant.
-    appendInt("threaded", sessionCount);
+    // Sessions served by the non-threaded ServiceExecutorFixed do not count as "threaded".
+    invariant(_svcCtx);
+    const size_t fixedSessions = [&]() -> size_t {
+        auto fixedExec = ServiceExecutorFixed::get(_svcCtx);
+        return fixedExec ? fixedExec->getClientsInTotal() : 0;
+    }();
+    appendInt("threaded", sessionCount - std::min<size_t>(sessionCount, fixedSessions));
     auto maxConnsOverride = serverGlobalParams.maxConnsOverride.makeSnapshot();
     if (maxConnsOverride && !maxConnsOverride->empty()) {
         appendInt("limitExempt", serviceExecutorStats.limitExempt.load());
@@ -108,7 +117,6 @@ void AsioSessionManager::appendStats(BSONObjBuilder* bob) const {
 
     helloMetrics.serialize(bob);
 
-    invariant(_svcCtx);
     if (auto adminExec = ServiceExecutorReserved::get(_svcCtx)) {
         BSONObjBuilder section(bob->subobjStart("adminConnections"));
         adminExec->appendStats(&section);
@@ -54,6 +54,7 @@
 #include "mongo/transport/asio/asio_tcp_fast_open.h"
 #include "mongo/transport/asio/asio_utils.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/errno_util.h"
@@ -1214,6 +1215,13 @@ Status AsioTransportLayer::start() {
             _listener.thread = stdx::thread([this] { _runListener(); });
             _listener.cv.wait(lk, [&] { return _listener.state != Listener::State::kNew; });
         }
+
+        if (gServiceExecutorFixedThreads > 0 && !_ingressReactorThread.joinable()) {
+            _ingressReactorThread = stdx::thread([reactor = _ingressReactor] {
+                setThreadName("IngressReactor");
+                reactor->run();
+            });
+        }
     } else {
         invariant(_acceptorRecords.empty());
     }
@@ -1239,6 +1247,13 @@ void AsioTransportLayer::shutdown() {
             LOGV2(20563, "SessionManager did not shutdown within the time limit");
         }
     }
+
+    // Ending the sessions above fails their pending readiness waits, which needs the reactor to
+    // still be running, so it is only stopped afterwards.
+    if (_ingressReactorThread.joinable()) {
+        _ingressReactor->stop();
+        _ingressReactorThread.join();
+    }
 }
 
 void AsioTransportLayer::stopAcceptingSessionsWithLock(stdx::unique_lock<stdx::mutex> lk) {
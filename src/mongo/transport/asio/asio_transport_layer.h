@@ -314,6 +314,11 @@ private:
     // with the acceptors epoll set, thus avoiding those wakeups.  Calling run will
     // undo that benefit.
     //
+    // The exception is when sessions are served by ServiceExecutorFixed, which parks idle
+    // sessions on readiness waits registered with the _ingressReactor. Only then does
+    // AsioTransportLayer run the _ingressReactor, on _ingressReactorThread, from start() until
+    // its sessions have been ended in shutdown().
+    //
     // AsioTransportLayer should run its own thread that calls run() on the _acceptorReactor
     // to process calls to async_accept - this is the equivalent of the "listener" thread in
     // other TransportLayers.
@@ -357,6 +362,8 @@ private:
     };
     Listener _listener;
 
+    stdx::thread _ingressReactorThread;
+
     std::shared_ptr<SessionManager> _sessionManager;
 
     Options _listenerOptions;
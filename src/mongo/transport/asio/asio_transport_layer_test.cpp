@@ -197,14 +197,19 @@ private:
     asio::ip::tcp::socket _sock{_ctx};
 };
 
-template <typename AsioWriter>
-void ping(AsioWriter& client) {
+Message makePingMessage() {
     OpMsgBuilder builder;
     builder.setBody(BSON("ping" << 1));
     Message msg = builder.finish();
     msg.header().setResponseToMsgId(0);
     msg.header().setId(0);
     OpMsg::appendChecksum(&msg);
+    return msg;
+}
+
+template <typename AsioWriter>
+void ping(AsioWriter& client) {
+    Message msg = makePingMessage();
     auto ec = client.write(msg.buf(), msg.size());
     ASSERT_FALSE(ec) << errorMessage(ec);
 }
@@ -458,6 +463,49 @@ TEST(AsioTransportLayer, SourceSyncTimeoutSucceeds) {
     ASSERT_OK(received.get().getStatus());
 }
 
+/**
+ * Requests that a client pipelines in one write are each sourced whole, and the session reports
+ * data as available for the ones it already read off the socket.
+ */
+TEST(AsioTransportLayer, SourceSyncPipelinedMessages) {
+    TestFixture tf;
+    Notification<test::SessionThread*> mockSessionCreated;
+    tf.sessionManager().setOnStartSession(
+        [&](test::SessionThread& st) { mockSessionCreated.set(&st); });
+
+    SyncClient conn(tf.tla().listenerPort());
+    auto& st = *mockSessionCreated.get();
+
+    {
+        // The first message is also where an ingress session checks for a TLS handshake.
+        Notification<StatusWith<Message>> done;
+        st.schedule([&](auto& session) { done.set(session.sourceMessage()); });
+        ping(conn);
+        ASSERT_OK(done.get().getStatus());
+    }
+
+    const int kPipelined = 3;
+    Message msg = makePingMessage();
+    std::string batch;
+    for (int i = 0; i < kPipelined; ++i) {
+        batch.append(msg.buf(), msg.size());
+    }
+    auto ec = conn.write(batch.data(), batch.size());
+    ASSERT_FALSE(ec) << errorMessage(ec);
+
+    for (int i = 0; i < kPipelined; ++i) {
+        Notification<StatusWith<Message>> done;
+        st.schedule([&](auto& session) {
+            auto status = session.waitForData();
+            done.set(status.isOK() ? session.sourceMessage() : StatusWith<Message>(status));
+        });
+        auto swMsg = done.get();
+        ASSERT_OK(swMsg.getStatus());
+        ASSERT_EQ(swMsg.getValue().size(), msg.size());
+        ASSERT_EQ(memcmp(swMsg.getValue().buf(), msg.buf(), msg.size()), 0);
+    }
+}
+
 /** Switching from timeouts to no timeouts must reset the timeout to unlimited. */
 TEST(AsioTransportLayer, SwitchTimeoutModes) {
     TestFixture tf;
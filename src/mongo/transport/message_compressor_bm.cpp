@@ -35,10 +35,13 @@
 #include <utility>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/message_compressor_parameters_gen.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
@@ -96,13 +99,51 @@ Message genericMsg() {
     return msg;
 }
 
+/**
+ * A reply carrying a batch of small documents that share one schema, like most find and getMore
+ * responses.
+ */
+Message cursorBatchMsg() {
+    BSONArrayBuilder batch;
+    for (int i = 0; i < 100; ++i) {
+        batch.append(BSON("_id" << i << "status"
+                                << "active"
+                                << "qty" << i * 7 % 13 << "price" << 1.5 * i));
+    }
+    OpMsgBuilder msgBuilder;
+    msgBuilder.setBody(BSON("cursor" << BSON("id" << 0LL << "ns"
+                                                  << "db.coll"
+                                                  << "firstBatch" << batch.arr())
+                                     << "ok" << 1.0));
+    auto msg = msgBuilder.finish();
+    msg.header().setId(123456);
+    msg.header().setResponseToMsgId(654321);
+    return msg;
+}
+
+/** A reply too small for compression to pay off. */
+Message tinyMsg() {
+    OpMsgBuilder msgBuilder;
+    msgBuilder.setBody(BSON("ok" << 1.0));
+    auto msg = msgBuilder.finish();
+    msg.header().setId(123456);
+    msg.header().setResponseToMsgId(654321);
+    return msg;
+}
+
 void setCompressor(MessageCompressorRegistry& registry,
                    std::unique_ptr<MessageCompressorBase> compressorType) {
     registry.setSupportedCompressors({compressorType->getName()});
     registry.registerImplementation(std::move(compressorType));
 }
 
-void runCompressBM(benchmark::State& state, std::unique_ptr<MessageCompressorBase> compressorType) {
+/**
+ * Reports throughput over the uncompressed bytes, whose inverse is the CPU time per byte, and the
+ * achieved compression ratio as the "ratio" counter.
+ */
+void runCompressBM(benchmark::State& state,
+                   std::unique_ptr<MessageCompressorBase> compressorType,
+                   Message sendMsg = genericMsg()) {
     MessageCompressorRegistry registry;
     MessageCompressorManager manager(&registry);
 
@@ -110,13 +151,16 @@ void runCompressBM(benchmark::State& state, std::unique_ptr<MessageCompressorBas
     setCompressor(registry, std::move(compressorType));
 
     size_t totalSize = 0;
-    Message sendMsg = genericMsg();
+    size_t compressedSize = 0;
     for (auto _ : state) {
         benchmark::ClobberMemory();
-        benchmark::DoNotOptimize(uassertStatusOK(manager.compressMessage(sendMsg, &compId)));
-        totalSize += sendMsg.dataSize();
+        auto compressed = uassertStatusOK(manager.compressMessage(sendMsg, &compId));
+        benchmark::DoNotOptimize(compressed);
+        totalSize += sendMsg.size();
+        compressedSize += compressed.size();
     }
     state.SetBytesProcessed(totalSize);
+    state.counters["ratio"] = compressedSize ? double(totalSize) / compressedSize : 0;
 }
 
 void runDecompressBM(benchmark::State& state,
@@ -163,6 +207,24 @@ void BM_zstd_decompress(benchmark::State& state) {
     runDecompressBM(state, std::make_unique<ZstdMessageCompressor>());
 }
 
+void BM_snappy_compressCursorBatch(benchmark::State& state) {
+    runCompressBM(state, std::make_unique<SnappyMessageCompressor>(), cursorBatchMsg());
+}
+
+void BM_zstd_compressCursorBatch(benchmark::State& state) {
+    runCompressBM(state, std::make_unique<ZstdMessageCompressor>(), cursorBatchMsg());
+}
+
+void BM_zstd_compressTiny(benchmark::State& state) {
+    runCompressBM(state, std::make_unique<ZstdMessageCompressor>(), tinyMsg());
+}
+
+void BM_zstd_compressTinyAdaptive(benchmark::State& state) {
+    gMessageCompressionAdaptiveBypass.store(true);
+    runCompressBM(state, std::make_unique<ZstdMessageCompressor>(), tinyMsg());
+    gMessageCompressionAdaptiveBypass.store(false);
+}
+
 BENCHMARK(BM_snappy_compress)->Ranges({{1, 1000}});
 BENCHMARK(BM_snappy_decompress)->Ranges({{1, 1000}});
 
@@ -171,5 +233,10 @@ BENCHMARK(BM_zlib_decompress)->Ranges({{1, 1000}});
 
 BENCHMARK(BM_zstd_compress)->Ranges({{1, 1000}});
 BENCHMARK(BM_zstd_decompress)->Ranges({{1, 1000}});
+
+BENCHMARK(BM_snappy_compressCursorBatch);
+BENCHMARK(BM_zstd_compressCursorBatch);
+BENCHMARK(BM_zstd_compressTiny);
+BENCHMARK(BM_zstd_compressTinyAdaptive);
 }  // namespace
 }  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/logv2/log_component.h"
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/message_compressor_parameters_gen.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/assert_util_core.h"
@@ -87,6 +88,11 @@ struct CompressionHeader {
     }
 };
 
+// After this many messages in a row that did not get smaller, the adaptive bypass stops
+// compressing for kAdaptiveBypassLength messages before it probes the traffic again.
+constexpr int kIncompressibleStreakLimit = 8;
+constexpr int kAdaptiveBypassLength = 64;
+
 const transport::Session::Decoration<MessageCompressorManager> getForSession =
     transport::Session::declareDecoration<MessageCompressorManager>();
 }  // namespace
@@ -110,6 +116,16 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
+    if (msg.dataSize() < gMessageCompressionMinSizeBytes.load()) {
+        return {msg};
+    }
+
+    const bool adaptiveBypass = gMessageCompressionAdaptiveBypass.load();
+    if (adaptiveBypass && _bypassRemaining > 0) {
+        --_bypassRemaining;
+        return {msg};
+    }
+
     LOGV2_DEBUG(22925, 3, "Compressing message", "compressor"_attr = compressor->getName());
 
     auto inputHeader = msg.header();
@@ -146,6 +162,18 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return sws.getStatus();
 
     auto realCompressedSize = sws.getValue();
+    if (adaptiveBypass) {
+        if (realCompressedSize + CompressionHeader::size() >= size_t(inputHeader.dataLen())) {
+            // The original message is at least as small, so the receiver is better off with it.
+            if (++_incompressibleStreak >= kIncompressibleStreakLimit) {
+                _incompressibleStreak = 0;
+                _bypassRemaining = kAdaptiveBypassLength;
+            }
+            return {msg};
+        }
+        _incompressibleStreak = 0;
+    }
+
     outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
 
     return {Message(outputMessageBuffer)};
@@ -101,7 +101,9 @@ public:
      * parameter value for compressorId from a call to decompressMessage.
      *
      * If _negotiated is empty (meaning compression was not negotiated or is not supported), then
-     * it will return a ref-count bumped copy of the input message.
+     * it will return a ref-count bumped copy of the input message. The same happens for messages
+     * that compression does not pay off for, as configured by the messageCompressionMinSizeBytes
+     * and messageCompressionAdaptiveBypass server parameters.
      *
      * If an error occurs in the compressor, it will return a Status error.
      */
@@ -135,6 +137,11 @@ public:
 private:
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+
+    // State of the adaptive bypass: the number of messages in a row that did not get smaller
+    // when compressed, and how many upcoming messages to send without trying.
+    int _incompressibleStreak = 0;
+    int _bypassRemaining = 0;
 };
 
 }  // namespace mongo
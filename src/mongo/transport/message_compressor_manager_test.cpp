@@ -50,6 +50,7 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
@@ -189,8 +190,7 @@ void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
         compressor->decompressData(tooSmallRange, DataRange(scratch.data(), scratch.size())));
 }
 
-Message buildMessage() {
-    const auto data = std::string{"Hello, world!"};
+Message buildMessage(const std::string& data = "Hello, world!") {
     const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
     auto buf = SharedBuffer::allocate(bufferSize);
     MsgData::View testView(buf.get());
@@ -262,6 +262,61 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+/** Returns a server-side manager that negotiated the first compressor of 'registry'. */
+MessageCompressorManager makeNegotiatedManager(MessageCompressorRegistry* registry) {
+    MessageCompressorManager manager(registry);
+    BSONObjBuilder serverOutput;
+    manager.serverNegotiate(std::vector<StringData>{registry->getCompressorNames().front()},
+                            &serverOutput);
+    ASSERT_EQ(manager.getNegotiatedCompressors().size(), 1U);
+    return manager;
+}
+
+TEST(MessageCompressorManager, SmallMessagesBypassCompression) {
+    RAIIServerParameterControllerForTest minSize{"messageCompressionMinSizeBytes", 1024};
+    auto registry = buildRegistry();
+    auto manager = makeNegotiatedManager(&registry);
+
+    auto msg = buildMessage();
+    auto out = assertOk(manager.compressMessage(msg));
+    ASSERT_EQ(out.operation(), dbQuery);
+    ASSERT_EQ(out.buf(), msg.buf());
+}
+
+TEST(MessageCompressorManager, AdaptiveBypassSendsIncompressibleMessagesAsIs) {
+    RAIIServerParameterControllerForTest adaptive{"messageCompressionAdaptiveBypass", true};
+    auto registry = buildRegistry();
+    auto manager = makeNegotiatedManager(&registry);
+
+    // The noop compressor never makes a message smaller, so every message goes out as is, both
+    // while the manager keeps probing and once it stops trying.
+    auto msg = buildMessage();
+    for (int i = 0; i < 100; ++i) {
+        auto out = assertOk(manager.compressMessage(msg));
+        ASSERT_EQ(out.operation(), dbQuery);
+        ASSERT_EQ(out.size(), msg.size());
+    }
+}
+
+TEST(MessageCompressorManager, AdaptiveBypassCompressesCompressibleMessages) {
+    RAIIServerParameterControllerForTest adaptive{"messageCompressionAdaptiveBypass", true};
+    MessageCompressorRegistry registry;
+    auto compressor = std::make_unique<ZstdMessageCompressor>();
+    registry.setSupportedCompressors({compressor->getName()});
+    registry.registerImplementation(std::move(compressor));
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+    auto manager = makeNegotiatedManager(&registry);
+
+    auto msg = buildMessage(std::string(4096, 'x'));
+    auto compressed = assertOk(manager.compressMessage(msg));
+    ASSERT_EQ(compressed.operation(), dbCompressed);
+    ASSERT_LT(compressed.size(), msg.size());
+
+    auto decompressed = assertOk(manager.decompressMessage(compressed));
+    ASSERT_EQ(decompressed.size(), msg.size());
+    ASSERT_EQ(memcmp(decompressed.buf(), msg.buf(), msg.size()), 0);
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, std::make_unique<NoopMessageCompressor>());
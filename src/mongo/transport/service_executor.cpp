@@ -39,6 +39,7 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_reserved.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/session_manager.h"
@@ -99,6 +100,7 @@ void forEachServiceExecutor(ServiceContext* svcCtx, const Func& func) {
     call(std::type_identity<ServiceExecutorSynchronous>{});
     call(std::type_identity<ServiceExecutorReserved>{});
     call(std::type_identity<ServiceExecutorInline>{});
+    call(std::type_identity<ServiceExecutorFixed>{});
 }
 
 }  // namespace
@@ -124,7 +126,7 @@ void ServiceExecutorContext::set(Client* client,
                 kDiagnosticLogLevel,
                 "Setting initial ServiceExecutor context for client",
                 "client"_attr = client->desc(),
-                "usesDedicatedThread"_attr = true,
+                "usesDedicatedThread"_attr = seCtx._threadModel != ThreadModel::kFixed,
                 "canUseReserved"_attr = seCtx._canUseReserved);
     serviceExecutorContext = std::move(seCtxPtr);
 }
@@ -192,6 +194,11 @@ ServiceExecutor* ServiceExecutorContext::getServiceExecutor() {
             _hasUsedSynchronous = true;
             return ServiceExecutorSynchronous::get(_client->getServiceContext());
         }
+        case ThreadModel::kFixed: {
+            if (auto exec = ServiceExecutorFixed::get(_client->getServiceContext()))
+                return exec;
+            return ServiceExecutorSynchronous::get(_client->getServiceContext());
+        }
     }
 
     MONGO_UNREACHABLE;
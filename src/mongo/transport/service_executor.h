@@ -120,9 +120,12 @@ class ServiceExecutorContext {
 public:
     // Roughly a 1:1 mapping to the ServiceExecutor type which will be used.
     // ThreadModel::kSynchronous + canUseReserved may result in ServiceExecutorReserved.
+    // ThreadModel::kFixed falls back to ServiceExecutorSynchronous when ServiceExecutorFixed is not
+    // configured.
     enum class ThreadModel {
         kSynchronous,
         kInline,
+        kFixed,
     };
 
     // Manually hoist these enum values into the class to aid callsite usage.
@@ -130,6 +133,7 @@ public:
     // `using enum ThreadModel;`
     static constexpr inline auto kSynchronous = ThreadModel::kSynchronous;
     static constexpr inline auto kInline = ThreadModel::kInline;
+    static constexpr inline auto kFixed = ThreadModel::kFixed;
 
     /**
      * Get a pointer to the ServiceExecutorContext for a given client.
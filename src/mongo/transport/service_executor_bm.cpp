@@ -33,15 +33,20 @@
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/mock_session.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/util/duration.h"
+#include "mongo/util/future.h"
 #include "mongo/util/processinfo.h"
 
 #define MONGO_LOGV2_DEFAULT_COMPONENT mongo::logv2::LogComponent::kTest
@@ -178,6 +183,163 @@ BENCHMARK_DEFINE_F(ServiceExecutorSynchronousBm, ChainedSchedule)(benchmark::Sta
     }
 }
 
+/**
+ * A session whose requests are delivered by the benchmark. `sourceRequest()` blocks until a
+ * request has been delivered and consumes it, as a blocking socket read would.
+ */
+class DeliverySession : public MockSession {
+public:
+    explicit DeliverySession(TransportLayer* tl) : MockSession(tl) {}
+
+    void deliver() {
+        _update([&] { ++_pending; });
+    }
+
+    void end() override {
+        _update([&] { _ended = true; });
+    }
+
+    Status waitForData() noexcept override {
+        stdx::unique_lock lk{_mutex};
+        _cv.wait(lk, [&] { return _pending || _ended; });
+        return _ended ? Status(ErrorCodes::SocketException, "Session is closed") : Status::OK();
+    }
+
+    Future<void> asyncWaitForData() noexcept override {
+        stdx::lock_guard lk{_mutex};
+        if (_pending || _ended)
+            return _ended ? Future<void>::makeReady(
+                                Status(ErrorCodes::SocketException, "Session is closed"))
+                          : Future<void>::makeReady();
+        auto pf = makePromiseFuture<void>();
+        _waiter.emplace(std::move(pf.promise));
+        return std::move(pf.future);
+    }
+
+    /** Returns false if the session ended before a request arrived. */
+    bool sourceRequest() {
+        if (!waitForData().isOK())
+            return false;
+        stdx::lock_guard lk{_mutex};
+        --_pending;
+        return true;
+    }
+
+private:
+    template <typename F>
+    void _update(F&& f) {
+        boost::optional<Promise<void>> waiter;
+        bool ended;
+        {
+            stdx::lock_guard lk{_mutex};
+            f();
+            ended = _ended;
+            waiter = std::exchange(_waiter, {});
+            _cv.notify_all();
+        }
+        if (!waiter)
+            return;
+        if (ended)
+            waiter->setError(Status(ErrorCodes::SocketException, "Session is closed"));
+        else
+            waiter->emplaceValue();
+    }
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _cv;
+    int _pending = 0;
+    bool _ended = false;
+    boost::optional<Promise<void>> _waiter;
+};
+
+/**
+ * Keeps `state.range(0)` client sessions open on the executor, most of them idle, and measures the
+ * rate at which requests delivered to a rotating subset of the sessions are served. Each session
+ * loops like a SessionWorkflow: wait for data, read the request, wait for data again. Reports the
+ * process RSS and thread count with all sessions idle, which is what thread-per-connection spends
+ * on idle connections.
+ */
+void runIdleSessions(benchmark::State& state, ServiceExecutor* executor) {
+    constexpr int kRequestsPerIteration = 64;
+    const int nSessions = state.range(0);
+
+    executor->start();
+
+    TransportLayerMock tl;
+    tl.createSessionHook = [](TransportLayer* tl) {
+        return std::make_shared<DeliverySession>(tl);
+    };
+
+    struct Connection {
+        std::shared_ptr<DeliverySession> session;
+        std::unique_ptr<ServiceExecutor::TaskRunner> runner;
+    };
+    std::vector<Connection> clients(nSessions);
+
+    stdx::mutex servedMutex;
+    stdx::condition_variable servedCv;
+    int64_t served = 0;
+
+    std::function<void(Connection*)> waitForRequest = [&](Connection* client) {
+        client->runner->runOnDataAvailable(client->session, [&, client](Status status) {
+            if (!status.isOK() || !client->session->sourceRequest())
+                return;
+            {
+                stdx::lock_guard lk{servedMutex};
+                ++served;
+                servedCv.notify_all();
+            }
+            waitForRequest(client);
+        });
+    };
+
+    for (auto&& client : clients) {
+        client.session = std::static_pointer_cast<DeliverySession>(tl.createSession());
+        client.runner = executor->makeTaskRunner();
+        waitForRequest(&client);
+    }
+
+    // Touch every session once so that all of them have been scheduled before measuring memory.
+    int64_t expected = 0;
+    auto serve = [&](int requests, size_t& next) {
+        for (int i = 0; i < requests; ++i) {
+            clients[next].session->deliver();
+            next = (next + 1) % clients.size();
+        }
+        expected += requests;
+        stdx::unique_lock lk{servedMutex};
+        servedCv.wait(lk, [&] { return served >= expected; });
+    };
+    size_t next = 0;
+    serve(nSessions, next);
+
+    ProcessInfo processInfo;
+    state.counters["rssMiB"] = processInfo.getResidentSize();
+    state.counters["threads"] = executor->getRunningThreads();
+
+    for (auto _ : state) {
+        serve(kRequestsPerIteration, next);
+    }
+    state.SetItemsProcessed(state.iterations() * kRequestsPerIteration);
+
+    for (auto&& client : clients)
+        client.session->end();
+    (void)executor->shutdown(Seconds{30});
+    // Idle sessions hold their last task until they are ended, so clear them only afterwards.
+    clients.clear();
+}
+
+void BM_idleSessionsSynchronous(benchmark::State& state) {
+    ServiceExecutorSynchronous executor;
+    runIdleSessions(state, &executor);
+}
+
+void BM_idleSessionsFixed(benchmark::State& state) {
+    const size_t threads = ProcessInfo::getNumLogicalCores();
+    ServiceExecutorFixed executor("bm", threads, threads);
+    runIdleSessions(state, &executor);
+}
+
 BENCHMARK_DEFINE_F(ServiceExecutorSynchronousBm, DummyBenchmark)(benchmark::State& state) {
     for (auto _ : state) {
     }
@@ -189,6 +351,11 @@ BENCHMARK_REGISTER_F(ServiceExecutorSynchronousBm, ScheduleAndWait)->ThreadRange
 BENCHMARK_REGISTER_F(ServiceExecutorSynchronousBm, ChainedSchedule)
     ->Range(1, kMaxChainSize)
     ->ThreadRange(1, kMaxThreads);
+
+// Thread-per-connection usually cannot reach 50k sessions under default process limits, so the
+// synchronous executor is only compared up to 10k.
+BENCHMARK(BM_idleSessionsSynchronous)->Arg(1'000)->Arg(10'000)->UseRealTime();
+BENCHMARK(BM_idleSessionsFixed)->Arg(1'000)->Arg(10'000)->Arg(50'000)->UseRealTime();
 #else
 BENCHMARK_REGISTER_F(ServiceExecutorSynchronousBm, DummyBenchmark);
 #endif
@@ -0,0 +1,318 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/transport/service_executor_fixed.h"
+
+// IWYU pragma: no_include "cxxabi.h"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+#include "mongo/base/error_codes.h"
+#include "mongo/base/string_data.h"
+#include "mongo/logv2/log.h"
+#include "mongo/logv2/log_attr.h"
+#include "mongo/logv2/log_component.h"
+#include "mongo/transport/service_executor_gen.h"
+#include "mongo/transport/service_executor_utils.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/decorable.h"
+#include "mongo/util/functional.h"
+#include "mongo/util/future.h"
+#include "mongo/util/out_of_line_executor.h"
+#include "mongo/util/scopeguard.h"
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+
+namespace mongo::transport {
+namespace {
+
+constexpr auto kExecutorName = "fixed"_sd;
+
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kClientsInTotal = "clientsInTotal"_sd;
+constexpr auto kClientsRunning = "clientsRunning"_sd;
+constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
+
+// How long a worker started beyond the configured pool size may stay idle before it exits.
+constexpr auto kSurplusWorkerIdleTimeout = Seconds{10};
+
+const auto getServiceExecutorFixed =
+    ServiceContext::declareDecoration<std::unique_ptr<ServiceExecutorFixed>>();
+
+const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionRegisterer{
+    "ServiceExecutorFixed", [](ServiceContext* ctx) {
+        if (!gServiceExecutorFixedThreads) {
+            return;
+        }
+
+        getServiceExecutorFixed(ctx) = std::make_unique<ServiceExecutorFixed>(
+            "client sessions",
+            static_cast<size_t>(gServiceExecutorFixedThreads),
+            static_cast<size_t>(gServiceExecutorFixedMaxThreads));
+    }};
+}  // namespace
+
+thread_local std::deque<ServiceExecutor::Task> ServiceExecutorFixed::_localWorkQueue = {};
+
+ServiceExecutorFixed::ServiceExecutorFixed(std::string name, size_t threads, size_t maxThreads)
+    : _name(std::move(name)), _threads(threads), _maxThreads(std::max(threads, maxThreads)) {}
+
+ServiceExecutorFixed* ServiceExecutorFixed::get(ServiceContext* ctx) {
+    auto& ref = getServiceExecutorFixed(ctx);
+
+    // The ServiceExecutorFixed could be absent, so nullptr is okay.
+    return ref.get();
+}
+
+void ServiceExecutorFixed::start() {
+    _stillRunning.store(true);
+
+    LOGV2(9031100,
+          "Starting worker threads for service executor",
+          "name"_attr = _name,
+          "threads"_attr = _threads,
+          "maxThreads"_attr = _maxThreads);
+    for (size_t i = 0; i < _threads; i++) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            ++_numWorkers;
+            ++_numStartingWorkers;
+        }
+        uassertStatusOK(_startWorker());
+    }
+}
+
+Status ServiceExecutorFixed::_startWorker() {
+    auto status = launchServiceWorkerThread([this] {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        --_numStartingWorkers;
+        _numRunningWorkerThreads.addAndFetch(1);
+        ScopeGuard numRunningGuard([&] {
+            _numRunningWorkerThreads.subtractAndFetch(1);
+            _shutdownCondition.notify_one();
+        });
+
+        while (_stillRunning.load()) {
+            ++_numIdleWorkers;
+            bool hasWork = _threadWakeup.wait_for(
+                lk, kSurplusWorkerIdleTimeout.toSystemDuration(), [&] {
+                    return (!_stillRunning.load() || !_readyTasks.empty());
+                });
+            --_numIdleWorkers;
+
+            if (!_stillRunning.loadRelaxed()) {
+                break;
+            }
+
+            if (!hasWork) {
+                if (_numWorkers > _threads) {
+                    --_numWorkers;
+                    LOGV2_DEBUG(9031104,
+                                3,
+                                "Exiting idle surplus worker thread in service executor",
+                                "name"_attr = _name);
+                    return;
+                }
+                continue;
+            }
+
+            auto task = std::move(_readyTasks.front());
+            _readyTasks.pop_front();
+            lk.unlock();
+
+            _localWorkQueue.emplace_back(std::move(task));
+            while (!_localWorkQueue.empty() && _stillRunning.loadRelaxed()) {
+                _localWorkQueue.front()(Status::OK());
+                _localWorkQueue.pop_front();
+            }
+            _failTasks(std::exchange(_localWorkQueue, {}));
+
+            lk.lock();
+        }
+
+        LOGV2_DEBUG(9031101, 3, "Exiting worker thread in service executor", "name"_attr = _name);
+    });
+
+    if (!status.isOK()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        --_numWorkers;
+        --_numStartingWorkers;
+    }
+    return status;
+}
+
+void ServiceExecutorFixed::_failTasks(std::deque<Task> tasks) {
+    for (auto&& task : tasks) {
+        task(Status(ErrorCodes::ShutdownInProgress, "Executor is not running"));
+    }
+}
+
+Status ServiceExecutorFixed::shutdown(Milliseconds timeout) {
+    LOGV2_DEBUG(9031102, 3, "Shutting down fixed executor");
+
+    std::deque<Task> unstartedTasks;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _stillRunning.store(false);
+        _threadWakeup.notify_all();
+        unstartedTasks = std::exchange(_readyTasks, {});
+    }
+
+    // Tasks left on the workers' local queues are failed by the workers themselves.
+    _failTasks(std::move(unstartedTasks));
+
+    stdx::unique_lock<stdx::mutex> lock(_mutex);
+    bool result = _shutdownCondition.wait_for(lock, timeout.toSystemDuration(), [this]() {
+        return _numRunningWorkerThreads.load() == 0;
+    });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "fixed executor couldn't shutdown all worker threads within time limit.");
+}
+
+void ServiceExecutorFixed::_schedule(Task task) {
+    if (!_stillRunning.load()) {
+        task(Status(ErrorCodes::ShutdownInProgress, "Executor is not running"));
+        return;
+    }
+
+    if (!_localWorkQueue.empty()) {
+        _localWorkQueue.emplace_back(std::move(task));
+        return;
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        // Checked again under the mutex, so that no task is queued after shutdown() has drained
+        // the queue.
+        if (!_stillRunning.load()) {
+            lk.unlock();
+            task(Status(ErrorCodes::ShutdownInProgress, "Executor is not running"));
+            return;
+        }
+
+        _readyTasks.push_back(std::move(task));
+        _threadWakeup.notify_one();
+
+        // Each idle or starting worker takes one queued task. Any task beyond those would wait for
+        // a running task to finish, which may block indefinitely, so give it a worker of its own
+        // unless the pool is already at its limit.
+        if (_readyTasks.size() <= _numIdleWorkers + _numStartingWorkers) {
+            return;
+        }
+        if (_numWorkers >= _maxThreads) {
+            LOGV2_DEBUG(9031105,
+                        2,
+                        "Service executor is at its thread limit; queueing task",
+                        "name"_attr = _name,
+                        "maxThreads"_attr = _maxThreads,
+                        "queuedTasks"_attr = _readyTasks.size());
+            return;
+        }
+        ++_numWorkers;
+        ++_numStartingWorkers;
+    }
+
+    if (auto status = _startWorker(); !status.isOK()) {
+        LOGV2_WARNING(9031103,
+                      "Failed to start an additional worker thread in service executor",
+                      "name"_attr = _name,
+                      "error"_attr = status);
+    }
+}
+
+/**
+ * Parks the session until its socket is readable, without occupying a worker thread, and then
+ * schedules the task. A failed wait is also delivered to the task on a worker thread, so that
+ * ending the session does not run on the reactor.
+ */
+void ServiceExecutorFixed::_runOnDataAvailable(const std::shared_ptr<Session>& session,
+                                               Task task) {
+    invariant(session);
+    if (!_stillRunning.load()) {
+        task(Status(ErrorCodes::ShutdownInProgress, "Executor is not running"));
+        return;
+    }
+
+    _numClientsWaiting.fetchAndAddRelaxed(1);
+    session->asyncWaitForData().getAsync([this, callback = std::move(task)](Status status) mutable {
+        _numClientsWaiting.fetchAndSubtractRelaxed(1);
+        _schedule([callback = std::move(callback),
+                   status = std::move(status)](Status scheduleStatus) mutable {
+            callback(scheduleStatus.isOK() ? std::move(status) : std::move(scheduleStatus));
+        });
+    });
+}
+
+void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
+    auto threads = static_cast<int>(_numRunningWorkerThreads.loadRelaxed());
+    auto total = static_cast<int>(_numClients.loadRelaxed());
+    auto waiting = std::min(static_cast<int>(_numClientsWaiting.loadRelaxed()), total);
+
+    BSONObjBuilder subbob = bob->subobjStart(kExecutorName);
+    subbob.append(kThreadsRunning, threads);
+    subbob.append(kClientsInTotal, total);
+    subbob.append(kClientsRunning, total - waiting);
+    subbob.append(kClientsWaiting, waiting);
+}
+
+auto ServiceExecutorFixed::makeTaskRunner() -> std::unique_ptr<TaskRunner> {
+    iassert(ErrorCodes::ShutdownInProgress, "Executor is not running", _stillRunning.load());
+
+    /** Schedules on this. */
+    class ForwardingTaskRunner : public TaskRunner {
+    public:
+        explicit ForwardingTaskRunner(ServiceExecutorFixed* e) : _e{e} {
+            _e->_numClients.fetchAndAddRelaxed(1);
+        }
+
+        ~ForwardingTaskRunner() override {
+            _e->_numClients.fetchAndSubtractRelaxed(1);
+        }
+
+        void schedule(Task task) override {
+            _e->_schedule(std::move(task));
+        }
+
+        void runOnDataAvailable(std::shared_ptr<Session> session, Task task) override {
+            _e->_runOnDataAvailable(std::move(session), std::move(task));
+        }
+
+    private:
+        ServiceExecutorFixed* _e;
+    };
+    return std::make_unique<ForwardingTaskRunner>(this);
+}
+
+}  // namespace mongo::transport
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/session.h"
+#include "mongo/util/duration.h"
+
+namespace mongo::transport {
+
+/**
+ * Runs client sessions on a pool of worker threads shared by all of its clients.
+ *
+ * Rather than blocking a thread in `waitForData()`, a session that is waiting for its next
+ * request registers for socket readiness with the reactor that owns its socket and returns its
+ * worker thread to the pool. The readiness notification schedules the session's next task onto the
+ * pool. The reactor is run by the transport layer that owns it, not by the executor.
+ *
+ * The pool keeps `threads` workers. A task may block its worker for a long time (e.g. an awaitable
+ * hello, a lock wait, or a TLS session reading its next request), so when a task is scheduled and
+ * no worker is free to take it, the pool starts another worker rather than queue the task behind
+ * blocked ones, up to `maxThreads` workers in total. Workers beyond `threads` exit once they have
+ * been idle for a while.
+ *
+ * As with the other executors, tasks scheduled while a task runs on a worker thread are queued on
+ * that thread and run in order after it. Tasks that have not run when the executor shuts down are
+ * called with a `ShutdownInProgress` status.
+ *
+ * The executor only exists when `serviceExecutorFixedThreads` is non-zero.
+ */
+class ServiceExecutorFixed final : public ServiceExecutor {
+public:
+    ServiceExecutorFixed(std::string name, size_t threads, size_t maxThreads);
+
+    /** Returns nullptr if the executor is not configured. */
+    static ServiceExecutorFixed* get(ServiceContext* ctx);
+
+    void start() override;
+    Status shutdown(Milliseconds timeout) override;
+
+    size_t getRunningThreads() const override {
+        return _numRunningWorkerThreads.loadRelaxed();
+    }
+
+    /** The number of clients that currently have a TaskRunner on this executor. */
+    size_t getClientsInTotal() const {
+        return _numClients.loadRelaxed();
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+    std::unique_ptr<TaskRunner> makeTaskRunner() override;
+
+    StringData getName() const override {
+        return "ServiceExecutorFixed"_sd;
+    }
+
+private:
+    /** Launches a worker thread that the caller has already counted in `_numStartingWorkers`. */
+    Status _startWorker();
+
+    /** Calls each task in `tasks` with a `ShutdownInProgress` status, in order. */
+    static void _failTasks(std::deque<Task> tasks);
+
+    void _schedule(Task task);
+
+    void _runOnDataAvailable(const std::shared_ptr<Session>& session, Task task);
+
+    static thread_local std::deque<Task> _localWorkQueue;
+
+    AtomicWord<bool> _stillRunning{false};
+
+    mutable stdx::mutex _mutex;
+    stdx::condition_variable _threadWakeup;
+    stdx::condition_variable _shutdownCondition;
+
+    std::deque<Task> _readyTasks;
+
+    AtomicWord<unsigned> _numRunningWorkerThreads{0};
+    AtomicWord<size_t> _numClients{0};
+    AtomicWord<size_t> _numClientsWaiting{0};
+
+    // Guarded by `_mutex`. `_numWorkers` counts the workers that are starting or running and have
+    // not decided to exit.
+    size_t _numWorkers = 0;
+    size_t _numStartingWorkers = 0;
+    size_t _numIdleWorkers = 0;
+
+    const std::string _name;
+    const size_t _threads;
+    const size_t _maxThreads;
+};
+
+}  // namespace mongo::transport
@@ -57,6 +57,7 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/mock_session.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/transport/transport_layer_mock.h"
@@ -136,6 +137,21 @@ private:
     asio::io_context _ioContext;
 };
 
+class ServiceExecutorFixedTest : public unittest::Test {
+public:
+    static constexpr size_t kThreads = 2;
+    static constexpr size_t kMaxThreads = 3;
+
+    /** Returns the executor's statistics from its `appendStats` output. */
+    BSONObj stats() {
+        BSONObjBuilder bob;
+        executor.appendStats(&bob);
+        return bob.obj()["fixed"].Obj().getOwned();
+    }
+
+    ServiceExecutorFixed executor{"test", kThreads, kMaxThreads};
+};
+
 class ServiceExecutorInlineTest : public unittest::Test {
 public:
     ServiceExecutorInline executor;
@@ -154,6 +170,10 @@ TEST_F(ServiceExecutorSynchronousTest, MakeTaskRunnerFailsBeforeStartup) {
     ASSERT_THROWS(executor.makeTaskRunner(), DBException);
 }
 
+TEST_F(ServiceExecutorFixedTest, MakeTaskRunnerFailsBeforeStartup) {
+    ASSERT_THROWS(executor.makeTaskRunner(), DBException);
+}
+
 // Schedule a task and ensure it has been executed.
 stdx::thread::id doBasicTaskRunTest(ServiceExecutor* executor) {
     boost::optional<stdx::thread::id> taskid;
@@ -184,6 +204,13 @@ TEST_F(ServiceExecutorInlineTest, BasicTaskRuns) {
     ASSERT(callerid == taskid);
 }
 
+TEST_F(ServiceExecutorFixedTest, BasicTaskRuns) {
+    auto callerid = stdx::this_thread::get_id();
+    auto taskid = doBasicTaskRunTest(&executor);
+    // Task runs on one of the pool's worker threads.
+    ASSERT(callerid != taskid);
+}
+
 /** Implements a threadsafe 1-shot pause and resume. */
 class Breakpoint {
 public:
@@ -263,6 +290,10 @@ TEST_F(ServiceExecutorInlineTest, TaskQueueing) {
     doTestTaskQueueing(&executor);
 }
 
+TEST_F(ServiceExecutorFixedTest, TaskQueueing) {
+    doTestTaskQueueing(&executor);
+}
+
 /** Ensure that tasks queued after a task queue has emptied will still run. */
 void doTestTaskPostQueueing(ServiceExecutor* executor) {
     executor->start();
@@ -301,5 +332,149 @@ TEST_F(ServiceExecutorInlineTest, TaskPostQueueing) {
     doTestTaskPostQueueing(&executor);
 }
 
+TEST_F(ServiceExecutorFixedTest, RunOnDataAvailableParksUntilDataArrives) {
+    TransportLayerMock tl;
+    auto session = tl.createSession();
+    executor.start();
+    auto runner = executor.makeTaskRunner();
+
+    PromiseAndFuture<stdx::thread::id> pf;
+    runner->runOnDataAvailable(session, [&](Status st) {
+        pf.promise.setWith([&] {
+            uassertStatusOK(st);
+            return stdx::this_thread::get_id();
+        });
+    });
+    ASSERT_EQ(stats()["clientsWaitingForData"].numberInt(), 1);
+    ASSERT_FALSE(pf.future.isReady());
+
+    checked_cast<MockSession*>(session.get())->signalAvailableData();
+    ASSERT_NE(pf.future.get(), stdx::this_thread::get_id());
+    ASSERT_EQ(stats()["clientsWaitingForData"].numberInt(), 0);
+
+    ASSERT_OK(executor.shutdown(kShutdownTime));
+}
+
+TEST_F(ServiceExecutorFixedTest, IdleSessionsDoNotHoldThreads) {
+    constexpr int kSessions = 100;
+    TransportLayerMock tl;
+    executor.start();
+
+    std::vector<std::shared_ptr<Session>> sessions;
+    std::vector<std::unique_ptr<ServiceExecutor::TaskRunner>> runners;
+    AtomicWord<int> ran{0};
+    AtomicWord<int> failed{0};
+    Notification<void> allRan;
+    for (int i = 0; i < kSessions; ++i) {
+        sessions.push_back(tl.createSession());
+        runners.push_back(executor.makeTaskRunner());
+        runners.back()->runOnDataAvailable(sessions.back(), [&](Status st) {
+            if (!st.isOK())
+                failed.fetchAndAdd(1);
+            if (ran.addAndFetch(1) == kSessions)
+                allRan.set();
+        });
+    }
+
+    auto parked = stats();
+    ASSERT_EQ(parked["clientsInTotal"].numberInt(), kSessions);
+    ASSERT_EQ(parked["clientsWaitingForData"].numberInt(), kSessions);
+    ASSERT_LTE(executor.getRunningThreads(), kThreads);
+
+    for (auto&& session : sessions)
+        checked_cast<MockSession*>(session.get())->signalAvailableData();
+    allRan.get();
+    ASSERT_EQ(failed.load(), 0);
+
+    ASSERT_OK(executor.shutdown(kShutdownTime));
+}
+
+TEST_F(ServiceExecutorFixedTest, GrowsPoolWhenAllWorkersAreBlocked) {
+    executor.start();
+    auto runner = executor.makeTaskRunner();
+
+    // Occupy every worker with a task that only returns once the test releases it.
+    std::vector<std::unique_ptr<Breakpoint>> blocked;
+    for (size_t i = 0; i < kThreads; ++i) {
+        blocked.push_back(std::make_unique<Breakpoint>());
+        runner->schedule([bp = blocked.back().get()](Status) { bp->pause(); });
+    }
+    for (auto&& bp : blocked)
+        bp->await();
+
+    // A task scheduled now must not wait for the blocked tasks to finish.
+    PromiseAndFuture<void> pf;
+    runner->schedule([&](Status st) { pf.promise.setFrom(st); });
+    ASSERT_DOES_NOT_THROW(pf.future.get());
+    ASSERT_GT(executor.getRunningThreads(), kThreads);
+
+    for (auto&& bp : blocked)
+        bp->resume();
+    ASSERT_OK(executor.shutdown(kShutdownTime));
+}
+
+TEST_F(ServiceExecutorFixedTest, QueuesTasksOnceAtMaxThreads) {
+    executor.start();
+    auto runner = executor.makeTaskRunner();
+
+    std::vector<std::unique_ptr<Breakpoint>> blocked;
+    for (size_t i = 0; i < kMaxThreads; ++i) {
+        blocked.push_back(std::make_unique<Breakpoint>());
+        runner->schedule([bp = blocked.back().get()](Status) { bp->pause(); });
+    }
+    for (auto&& bp : blocked)
+        bp->await();
+
+    // The pool is at its limit, so this task waits for one of the blocked ones to finish.
+    PromiseAndFuture<void> pf;
+    runner->schedule([&](Status st) { pf.promise.setFrom(st); });
+    sleepFor(Milliseconds{100});
+    ASSERT_FALSE(pf.future.isReady());
+    ASSERT_EQ(executor.getRunningThreads(), kMaxThreads);
+
+    blocked.front()->resume();
+    ASSERT_DOES_NOT_THROW(pf.future.get());
+    ASSERT_EQ(executor.getRunningThreads(), kMaxThreads);
+
+    for (auto&& bp : blocked)
+        bp->resume();
+    ASSERT_OK(executor.shutdown(kShutdownTime));
+}
+
+TEST_F(ServiceExecutorFixedTest, ShutdownFailsTasksThatHaveNotRun) {
+    executor.start();
+    auto runner = executor.makeTaskRunner();
+
+    // Fill the pool. The first task also queues a follow-up on its worker's local queue.
+    PromiseAndFuture<void> followUp;
+    std::vector<std::unique_ptr<Breakpoint>> blocked;
+    for (size_t i = 0; i < kMaxThreads; ++i) {
+        blocked.push_back(std::make_unique<Breakpoint>());
+        runner->schedule([&, bp = blocked.back().get(), first = (i == 0)](Status) {
+            if (first) {
+                runner->schedule([&](Status st) { followUp.promise.setFrom(st); });
+            }
+            bp->pause();
+        });
+    }
+    for (auto&& bp : blocked)
+        bp->await();
+
+    PromiseAndFuture<void> queued;
+    runner->schedule([&](Status st) { queued.promise.setFrom(st); });
+
+    Status shutdownStatus = Status::OK();
+    {
+        unittest::JoinThread shutdownThread(
+            [&] { shutdownStatus = executor.shutdown(kShutdownTime); });
+        ASSERT_EQ(queued.future.getNoThrow(), ErrorCodes::ShutdownInProgress);
+
+        for (auto&& bp : blocked)
+            bp->resume();
+        ASSERT_EQ(followUp.future.getNoThrow(), ErrorCodes::ShutdownInProgress);
+    }
+    ASSERT_OK(shutdownStatus);
+}
+
 }  // namespace
 }  // namespace mongo::transport
@@ -797,10 +797,12 @@ void SessionWorkflow::Impl::_scheduleIteration() try {
         }
 
         try {
-            // All available service executors use dedicated threads, so it's okay to
-            // run eager futures in an ordinary loop to bypass scheduler overhead. Loop
-            // while we have `_nextWork` in case there have been synthetic exhaust
-            // requests produced on this iteration.
+            // Every service executor lets this task keep its thread until the
+            // iteration completes (ServiceExecutorFixed only returns threads to its
+            // pool between iterations), so it's okay to run eager futures in an
+            // ordinary loop to bypass scheduler overhead. Loop while we have
+            // `_nextWork` in case there have been synthetic exhaust requests
+            // produced on this iteration.
             do {
                 _doOneIteration().get();
                 _work = nullptr;
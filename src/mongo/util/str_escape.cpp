@@ -37,7 +37,14 @@
 
 #include <fmt/format.h>
 
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "mongo/base/error_codes.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -49,10 +56,6 @@ constexpr char kHexChar[] = "0123456789abcdef";
 /** UTF8 encoding of Unicode REPLACEMENT CHARACTER U+FFFD, or "\xef\xbf\xbd". */
 const StringData unicodeReplacementCharacterUtf8{u8"\ufffd"_as_char_ptr};
 
-struct NoopBuffer {
-    void append(const char* begin, const char* end) {}
-};
-
 // Appends the bytes in the range [begin, end) to the output buffer,
 // which can either be a fmt::memory_buffer, or a std::string.
 template <typename Buffer, typename Iterator>
@@ -218,6 +221,33 @@ void escape(Buffer& buffer,
         *wouldWrite = total;
     }
 }
+
+constexpr ptrdiff_t kAsciiBlockSize = 16;
+
+/**
+ * Returns how many of the kAsciiBlockSize bytes starting at 'ptr' are ASCII before the first byte
+ * that is not. Returns kAsciiBlockSize if they all are.
+ */
+inline ptrdiff_t countLeadingAsciiBytes(const uint8_t* ptr) {
+#if defined(_M_AMD64) || defined(__amd64__)
+    uint32_t nonAscii = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+    if (MONGO_likely(!nonAscii)) {
+        return kAsciiBlockSize;
+    }
+    return countTrailingZerosNonZero32(nonAscii);
+#else
+#if defined(__aarch64__)
+    if (MONGO_likely(vmaxvq_u8(vld1q_u8(ptr)) < 0x80)) {
+        return kAsciiBlockSize;
+    }
+#endif
+    ptrdiff_t i = 0;
+    while (i < kAsciiBlockSize && ptr[i] < 0x80) {
+        ++i;
+    }
+    return i;
+#endif
+}
 }  // namespace
 
 template <typename Buffer>
@@ -518,30 +548,52 @@ std::string escapeForJSON(StringData str, size_t maxLength, size_t* wouldWrite)
 }
 
 bool validUTF8(StringData str) {
-    // No-op buffer and handlers, defined to re-use escape method logic.
-    NoopBuffer buffer;
-    auto singleByteHandler = [](const auto& writer, uint8_t unescaped) {
-    };
-    auto twoByteEscaper = [](const auto& writer, uint8_t first, uint8_t second) {
-    };
+    auto it = reinterpret_cast<const uint8_t*>(str.data());
+    auto end = it + str.size();
 
-    // Throws an exception when an invalid UTF8 character is detected.
-    auto invalidByteHandler = [](const auto& writer, uint8_t) {
-        uasserted(ErrorCodes::BadValue, "Invalid UTF-8 Character");
-    };
+    while (it != end) {
+        // Most strings are entirely or mostly ASCII, so skip over runs of it a block at a time.
+        while (end - it >= kAsciiBlockSize) {
+            auto asciiBytes = countLeadingAsciiBytes(it);
+            it += asciiBytes;
+            if (asciiBytes != kAsciiBlockSize) {
+                break;
+            }
+        }
+        if (it == end) {
+            break;
+        }
 
-    try {
-        escape(buffer,
-               str,
-               std::move(singleByteHandler),
-               std::move(invalidByteHandler),
-               std::move(twoByteEscaper),
-               std::string::npos,
-               nullptr);
-        return true;
-    } catch (const ExceptionFor<ErrorCodes::BadValue>&) {
-        return false;
+        uint8_t c = *it;
+        if (c < 0x80) {
+            ++it;
+            continue;
+        }
+
+        // This accepts the same sequences as escape(): the lead byte determines the length of the
+        // sequence and all following bytes of it must be continuation bytes.
+        ptrdiff_t len;
+        if ((c & 0xe0) == 0xc0) {
+            len = 2;
+        } else if ((c & 0xf0) == 0xe0) {
+            len = 3;
+        } else if ((c & 0xf8) == 0xf0) {
+            len = 4;
+        } else {
+            return false;
+        }
+
+        if (end - it < len) {
+            return false;
+        }
+        for (ptrdiff_t i = 1; i < len; ++i) {
+            if ((it[i] & 0xc0) != 0x80) {
+                return false;
+            }
+        }
+        it += len;
     }
+    return true;
 }
 
 std::string scrubInvalidUTF8(StringData str) {
@@ -463,5 +463,22 @@ TEST(StringEscapeTest, ValidUTF8) {
     }
 }
 
+TEST(StringEscapeTest, ValidUTF8AtEveryOffsetOfLongString) {
+    // validUTF8 skips over ASCII in blocks, so place each sequence at every offset relative to the
+    // block boundaries.
+    for (size_t offset = 0; offset < 40; ++offset) {
+        for (auto& str : validUTF8Strings) {
+            std::string s = std::string(offset, 'a') + str + std::string(40, 'b');
+            ASSERT(str::validUTF8(s)) << offset << " " << s;
+        }
+        for (const auto& pair : scrubMap) {
+            std::string s = std::string(offset, 'a') + pair.first + std::string(40, 'b');
+            ASSERT(!str::validUTF8(s)) << offset << " " << s;
+            // Truncated sequences at the very end of the string.
+            ASSERT(!str::validUTF8(std::string(offset, 'a') + pair.first)) << offset;
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo::str